@@ -0,0 +1,25 @@
+#pragma once
+
+#include "genome.h"
+#include <stdio.h>
+
+/* Backend used for NN activation functions */
+typedef enum {
+    ACTIVATION_EXACT = 0,  /* libm expf/tanhf/sinf/cosf — default, reproduces old runs */
+    ACTIVATION_FAST        /* rational and table approximations, see activation.c for error bounds */
+} ActivationMode;
+
+/* Select the backend. Call once at startup, before any simulation step. */
+void ActivationSetMode(ActivationMode mode);
+ActivationMode ActivationGetMode(void);
+
+/* Apply activation fn to x with the selected backend */
+float ActivationApply(ActivationFunc fn, float x);
+
+/* Output-stage squashing functions, same backend */
+float ActivationTanh(float x);
+float ActivationSigmoid(float x);
+
+/* Write max absolute error of the fast backend against libm and ns/call of
+   both backends for every ActivationFunc (--activation-report) */
+void ActivationReport(FILE *out);
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "settings.h"
+
+/* Headless benchmark (--benchmark TICKS): runs the simulation from the same
+   seed once per staggered-sensing cohort count K = 1, 2, 4, 8 and prints
+   ms/tick next to population, species and mean-trait outcomes, so the cost
+   saving of staggered sensing can be weighed against its evolutionary effect.
+   A second table holds the population at N = 500 … 4000, at constant density
+   and in the fixed world, and prints the contact phase's cost per creature.
+   The last two compare the dense and hashed grid layouts: tick cost and grid
+   memory in the configured world and a 10× larger one, then ns per spatial
+   query (radius, nearest in a cone, picking, view rect). */
+void BenchmarkRun(const SimParams *params, int ticks);
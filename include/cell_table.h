@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* List heads of a uniform grid — one int per cell, -1 = empty list — in one
+   of two layouts behind the same interface:
+   - dense: a plain array over every cell, one load per lookup;
+   - hashed: open addressing with linear probing over only the cells that
+     hold something, so memory follows the occupied cells rather than the
+     world area — for huge, sparsely populated worlds.
+   CELL_TABLE_AUTO hashes when the grid has more than CELL_TABLE_SPARSE_RATIO
+   cells per item the table can hold. */
+typedef enum {
+    CELL_TABLE_AUTO = 0,
+    CELL_TABLE_DENSE,
+    CELL_TABLE_HASHED
+} CellTableMode;
+
+/* Hashed slot: key and head side by side so a probe touches one cache line */
+typedef struct {
+    int key;       /* cell filed here, -1 = free */
+    int head;
+} CellTableEntry;
+
+typedef struct {
+    int            *head;   /* dense: list head per cell  [cells] */
+    CellTableEntry *slot;   /* hashed: open-addressed     [cap]   */
+    int   cells;
+    int   cap;     /* hashed: slots, a power of two */
+    int   shift;   /* hashed: 32 − log2(cap), for Fibonacci hashing */
+    int   used;    /* hashed: slots holding a cell, including emptied lists */
+    bool  hashed;
+} CellTable;
+
+/* Set up an all-empty table for `cells` cells that will hold up to
+   maxItems items (only used by CELL_TABLE_AUTO to pick the layout) */
+void CellTableInit(CellTable *t, int cells, int maxItems, CellTableMode mode);
+void CellTableFree(CellTable *t);
+
+/* Home slot of a cell in the hashed layout */
+static inline unsigned CellTableSlot(const CellTable *t, int cell) {
+    return ((unsigned)cell * 2654435769u) >> t->shift;
+}
+
+/* Head of cell's list, -1 if empty */
+static inline int CellTableGet(const CellTable *t, int cell) {
+    if (!t->hashed) return t->head[cell];
+    unsigned mask = (unsigned)t->cap - 1;
+    for (unsigned s = CellTableSlot(t, cell); ; s = (s + 1) & mask) {
+        if (t->slot[s].key == cell) return t->slot[s].head;
+        if (t->slot[s].key == -1)   return -1;
+    }
+}
+
+/* Set the head of cell's list. A hashed cell stays filed (with head -1)
+   after its list empties, until a rehash drops it, so any write to a cell
+   whose list is non-empty — every unlink — changes one int in place: strip
+   workers may do that for cells they own while others read. Filing a new
+   cell may rehash, so inserting into an empty cell is for the main thread
+   outside the parallel phases. */
+void CellTableSet(CellTable *t, int cell, int head);
+
+/* Bytes of memory the table holds */
+size_t CellTableBytes(const CellTable *t);
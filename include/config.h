@@ -7,6 +7,7 @@
 #define TARGET_FPS        60
 
 /* ── Simulation world (the toroidal box creatures live in) ───── */
+/*    Defaults — override at startup with --world-width/--world-height */
 #define WORLD_WIDTH     12000
 #define WORLD_HEIGHT     9000
 
@@ -22,30 +23,93 @@
 #define CAMERA_ZOOM_STEP 0.12f   /* fraction of current zoom per wheel tick */
 
 /* ── Food ────────────────────────────────────────────────────── */
-#define MAX_FOOD          8000
-#define FOOD_TARGET       2000    /* maximum food items in the world at once */
+#define MAX_FOOD          8000    /* default pool cap (--max-food) */
+#define FOOD_TARGET       2000    /* maximum plant items in the world at once */
 #define FOOD_SPAWN_RATE   1.5f    /* new food items spawned per second (rate-limited) */
 #define FOOD_NUTRITION   20.0f
 #define FOOD_SIZE         5.0f
 
+/* ── Fertility (where plants spawn, --fertility) ─────────── */
+/*    Relative spawn weight per grid cell. The generated map sums */
+/*    FERTILITY_OCTAVES of tileable value noise, the coarsest with */
+/*    features ~FERTILITY_FEATURE_CELLS cells across; noise below  */
+/*    FERTILITY_BARREN is near-desert. No cell drops below the     */
+/*    floor, so every region still sees some food. Worlds of more  */
+/*    than FERTILITY_MAX_CELLS grid cells get one weight per block */
+/*    of cells instead, so the map never outgrows that budget.     */
+#define FERTILITY_FEATURE_CELLS  16
+#define FERTILITY_OCTAVES         3
+#define FERTILITY_BARREN       0.45f
+#define FERTILITY_FLOOR        0.05f
+#define FERTILITY_MAX_CELLS    (1 << 20)
+
+/* ── Seasons (food supply schedule, UI toggle) ─────────────── */
+/*    See seasons.c for each season's spawn-rate and cap factors. */
+#define SEASON_TICKS  ((int)(90.0f / FIXED_DT))   /* 90 s per season */
+
+/* ── Meat (corpses) ──────────────────────────────────────────── */
+/*    A creature that dies of hunger or old age leaves one meat    */
+/*    item worth MEAT_YIELD × its max energy, in the food pool and */
+/*    grid, which rots after MEAT_LIFETIME_TICKS. Eaters gain       */
+/*    carnivory × meat nutrition, (1 − carnivory) × plant. Kills    */
+/*    leave nothing — the hunter has already fed.                   */
+#define MEAT_YIELD            0.5f
+#define MEAT_LIFETIME_TICKS   ((int)(30.0f / FIXED_DT))   /* 30 s */
+
 /* ── Creatures ───────────────────────────────────────────────── */
-#define MAX_CREATURES     3000
+#define MAX_CREATURES     3000    /* default population cap (--max-creatures) */
 #define INITIAL_CREATURES  20
 
 /* Creature defaults (used as fallback / size for initial spawn bounds) */
 #define CREATURE_MAX_ENERGY   100.0f
 #define CREATURE_SIZE           6.0f   /* body radius px — used for spawn bounds only */
 
+/* ── Rendering level of detail (camera zoom thresholds) ────── */
+#define LOD_FOV_ZOOM         0.6f   /* FOV sectors + outlines at or above this zoom */
+#define LOD_BODY_ZOOM        0.2f   /* body circles at or above this zoom, batched points below */
+#define CREATURE_DRAW_REACH 24.0f   /* max body/heading-line extent px, for culling margins */
+
+/* ── Cached world layers (render textures) ───────────────────── */
+#define GRID_TILE_TEXELS         256          /* background/grid cell tile resolution */
+#define FOOD_TILE_CELLS            8          /* food layer tile edge, in grid cells (minimum) */
+#define FOOD_TILE_MAX            256          /* food layer tiles — edges widen for huge worlds */
+#define FOOD_LAYER_MAX_SCALE     0.25f        /* food layer texels per world px (upper bound) */
+#define FOOD_LAYER_TEXEL_BUDGET  (4096*4096)  /* whole food layer — scale shrinks for huge worlds */
+#define FOOD_DIRTY_MAX           1024         /* dirty cells listed per frame; past it, repaint all */
+
+/* ── Sensors (k-nearest targets inside the vision cone) ───── */
+/*    Each target feeds distance/vision, sin and cos of its      */
+/*    bearing; missing targets read (1, 0, 0). Inputs are laid  */
+/*    out food targets, creature targets, energy, bias.         */
+#define SENSE_FOOD_K          3
+#define SENSE_CREATURE_K      2
+#define SENSE_TARGET_INPUTS   3
+#define SENSE_CONE_INPUTS     (SENSE_TARGET_INPUTS * (SENSE_FOOD_K + SENSE_CREATURE_K))
+
+/* ── Raycast sensors (--sensors rays) ──────────────────────── */
+/*    The genome's ray count (1..MAX) rays span the vision cone  */
+/*    edge to edge; each reports distance/vision and hit type   */
+/*    (+1 food, -1 creature, 0 nothing) of the first object it  */
+/*    hits, traced cell by cell through the grids (DDA).        */
+#define SENSE_RAYS_MAX        7
+#define SENSE_RAY_INPUTS      2
+#define SENSE_RAY_INPUTS_ALL  (SENSE_RAY_INPUTS * SENSE_RAYS_MAX)
+
 /* ── Neural network ──────────────────────────────────────────── */
-#define NN_INPUTS    7
+/*    Sensor block (cone or ray layout, whichever is larger),   */
+/*    then energy and bias                                       */
+#define SENSE_INPUTS (SENSE_CONE_INPUTS > SENSE_RAY_INPUTS_ALL ? SENSE_CONE_INPUTS : SENSE_RAY_INPUTS_ALL)
+#define NN_INPUTS    (SENSE_INPUTS + 2)
 #define NN_OUTPUTS   3
 
-/* Dynamic topology constants (NEAT-style) */
-#define NN_HIDDEN_MAX         8
-#define NN_CONN_MAX          64
+/* Dynamic topology constants (NEAT-style). Genomes are variable-length
+   (see genome.h), so the only bound left is the byte-sized node id space:
+   inputs first, hidden nodes after them, outputs in the last ids. */
+#define NN_NODE_COUNT         256
 #define NN_NODE_HIDDEN_BASE   NN_INPUTS
-#define NN_NODE_OUT_BASE      (NN_INPUTS + NN_HIDDEN_MAX)
-#define NN_NODE_COUNT         (NN_INPUTS + NN_HIDDEN_MAX + NN_OUTPUTS)
+#define NN_NODE_OUT_BASE      (NN_NODE_COUNT - NN_OUTPUTS)
+#define NN_HIDDEN_LIMIT       (NN_NODE_OUT_BASE - NN_NODE_HIDDEN_BASE)
+#define NN_CONN_LIMIT         65535   /* connCount is 16-bit */
 
 /* ── Population floor ────────────────────────────────────────── */
 #define MIN_POPULATION    10     /* respawn random creatures when alive count falls below this */
@@ -55,10 +119,54 @@
 #define REPRODUCE_NN_THRESHOLD     0.7f   /* output[2] must exceed this */
 #define REPRODUCE_ENERGY_COST       0.5f    /* fraction of energy passed to child */
 #define REPRODUCE_COOLDOWN          8.0f    /* seconds before creature can reproduce again */
+#define MATE_RADIUS               60.0f    /* px (capped at vision): ready creatures this close pair up */
+#define MATE_PATIENCE              1.0f    /* s ready without a mate before reproducing asexually */
+
+/* ── Speciation (NEAT compatibility distance) ──────────────── */
+/*    δ = C_DISJOINT × unmatched conns / N + C_WEIGHT × mean |Δw| */
+/*    over matched conns, N = larger connection count. Only      */
+/*    species whose topology SimHash is within HASH_RADIUS bits  */
+/*    of the child's are compared.                               */
+#define SPECIES_C_DISJOINT      1.0f
+#define SPECIES_C_WEIGHT        0.4f
+#define SPECIES_THRESHOLD       1.5f   /* δ below this → same species */
+#define SPECIES_HASH_RADIUS     10     /* max Hamming distance of 32-bit topology hashes */
 
 /* ── Vision cost (energy/sec per unit of cone area: vision² × halfAngle) ── */
 #define VISION_COST_SCALE           0.00005f
 
+/* ── Predation (carnivory trait, creature contact phase) ─── */
+/*    Bodies touch when centres are closer than the sum of radii */
+/*    (≤ 24px, inside every Verlet list). A creature whose diet  */
+/*    is at least MIN_CARNIVORY kills a touching creature it     */
+/*    outsizes by SIZE_RATIO and gains YIELD × the prey's max    */
+/*    energy × its carnivory. Plants give (1 − carnivory) of     */
+/*    their nutrition, so a diet is a trade-off, not a bonus.    */
+#define PREDATION_MIN_CARNIVORY  0.4f
+#define PREDATION_SIZE_RATIO     1.2f
+#define PREDATION_YIELD          0.8f
+#define PREDATION_COOLDOWN       3.0f    /* s between kills */
+
+/* ── Body separation (soft-body collisions, UI toggle) ─────── */
+/*    Found in the contact pass: each creature is pushed away   */
+/*    from every body overlapping its own, by STIFFNESS of the  */
+/*    overlap per tick in total, the lighter (size²) body moving */
+/*    more. All pushes are computed before any is applied.      */
+#define SEPARATION_STIFFNESS     0.5f
+
+/* ── Disease (SIR epidemic over the creature grid) ──────────── */
+/*    Each tick every sick creature may infect each susceptible one */
+/*    within DISEASE_RADIUS with chance DISEASE_TRANSMIT × dt. The   */
+/*    sick drain energy DISEASE_DRAIN_MULT× faster, recover after    */
+/*    DISEASE_SICK_TICKS and stay immune for DISEASE_IMMUNE_TICKS.   */
+#define DISEASE_RADIUS          30.0f   /* px between centres, < GRID_CELL_SIZE */
+#define DISEASE_TRANSMIT         0.5f   /* per second of exposure to one sick creature */
+#define DISEASE_DRAIN_MULT       1.6f
+#define DISEASE_SICK_TICKS      ((int)(20.0f / FIXED_DT))   /* 20 s */
+#define DISEASE_IMMUNE_TICKS    ((int)(60.0f / FIXED_DT))   /* 60 s */
+#define DISEASE_OUTBREAK_RATE    0.01f  /* spontaneous patient zeros per second (UI toggle) */
+#define DISEASE_OUTBREAK_SEEDS  10      /* creatures infected by the Outbreak button */
+
 /* ── Size/weight energy scaling (reference radius = CREATURE_SIZE) ────── */
 /*    maxEnergy  = CREATURE_MAX_ENERGY × (size/CREATURE_SIZE)²            */
 /*    drain cost = base × (size/CREATURE_SIZE)²                           */
@@ -66,10 +174,43 @@
 /* ── Spatial grid (food & creature proximity queries) ─────── */
 /*    Cell size should be >= max eat radius so 3×3 cell check   */
 /*    always covers eating; vision queries scale with radius.   */
+/*    Column/row counts are derived from the runtime world size */
+/*    (World.gridCols/gridRows — 60×45 for the default world).  */
 #define GRID_CELL_SIZE  200
-#define GRID_COLS       (WORLD_WIDTH  / GRID_CELL_SIZE)   /* 60  */
-#define GRID_ROWS       (WORLD_HEIGHT / GRID_CELL_SIZE)   /* 45  */
-#define GRID_CELL_COUNT (GRID_COLS * GRID_ROWS)           /* 2700 */
+
+/*    Grid list heads are a dense per-cell array unless the world */
+/*    has more than SPARSE_RATIO cells per item (creature or food */
+/*    cap): then only occupied cells are kept, in a hash table    */
+/*    (cell_table.h, --grid).                                     */
+#define CELL_TABLE_SPARSE_RATIO  16
+
+/* ── Heap pools ──────────────────────────────────────────────── */
+/*    Creature and food pools start at this many slots and      */
+/*    double on demand up to their runtime caps.                */
+#define POOL_INITIAL_CAPACITY  256
+
+/* ── Threading (spatial domain decomposition) ─────────────── */
+/*    The world is split into DOMAIN_STRIPS horizontal bands of */
+/*    grid rows; each band is one job for the worker pool.      */
+/*    Must be even; small worlds use fewer (see domain.c).      */
+#define DOMAIN_STRIPS        8
+#define WORKER_THREADS_MAX  16
+
+/* ── Verlet neighbour lists (creature–creature queries) ──── */
+/*    Each list holds every creature within vision + NBR_SKIN at */
+/*    build time. It stays exact while own displacement plus the */
+/*    fastest creature's possible travel since the build is ≤ the */
+/*    skin; creatures born since are read from a birth log.      */
+#define NBR_SKIN          40.0f
+#define NBR_BIRTH_LOG     1024    /* ring size; older lists rebuild */
+
+/* ── Staggered sensing (optional, UI toggle) ───────────────── */
+/*    Creatures split into K cohorts by id; one cohort re-queries */
+/*    the grids per tick, the rest reuse cached targets. K doubles */
+/*    while the simulation's share of a frame exceeds the budget   */
+/*    and halves once it drops below 40% of it.                    */
+#define SENSE_COHORTS_MAX     8
+#define SENSE_FRAME_BUDGET    0.008f   /* s of SimulationUpdate per frame */
 
 /* ── Simulation ──────────────────────────────────────────────── */
 #define FIXED_DT  (1.0f / 60.0f)
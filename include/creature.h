@@ -4,6 +4,12 @@
 #include "config.h"
 #include "genome.h"
 
+/* Which sensor model fills the NN's sensor inputs (fixed per run, --sensors) */
+typedef enum {
+    SENSORS_CONE = 0,  /* k nearest food and creatures inside the vision cone */
+    SENSORS_RAYS       /* genome-configured rays across the cone, first hit each */
+} SensorMode;
+
 typedef struct {
     int     id;
     Vector2 position;
@@ -17,23 +23,53 @@ typedef struct {
     float   visionAngle;  /* half-angle of FOV cone radians (= genome.visionAngle) */
     float   metabolism;   /* base energy drain per second (= genome.metabolism) */
     float   size;         /* body radius px (= genome.size) */
-    /* genome.lifespan is used directly — no separate lifespan field */
-    /* Genome and NN state */
-    Genome  genome;
+    int     rays;         /* vision rays, SENSORS_RAYS only (= genome.rays rounded) */
+    float   carnivory;    /* diet: plant share 1 − carnivory, hunts above PREDATION_MIN_CARNIVORY */
+    /* genome->lifespan is used directly — no separate lifespan field */
+    /* Genome (shared, owned by the simulation's genome pool) and NN state */
+    const Genome *genome;
+    int     genomeId;     /* genome pool handle (set by the simulation on spawn) */
     float   nnInputs[NN_INPUTS];          /* last NN input values, for visualization */
-    float   hiddenOut[NN_HIDDEN_MAX];     /* last NN hidden activations, for visualization */
+    /* Sensor cache — nearest-first targets found by the last full grid query (staggered sensing;
+       SENSORS_RAYS reuses the last ray inputs in nnInputs instead) */
+    Vector2 foodTargets[SENSE_FOOD_K];
+    Vector2 crTargets[SENSE_CREATURE_K];
+    int     foodTargetCount;
+    int     crTargetCount;
+    bool    sensed;               /* false until the first full query */
     float   nnOutputs[NN_OUTPUTS];        /* last NN output values, for visualization */
     /* Internal state */
     float   facing;               /* current facing angle in radians */
     float   reproductionCooldown; /* seconds remaining before can reproduce again */
+    float   attackCooldown;       /* seconds remaining before can kill again */
+    float   courting;             /* seconds ready to reproduce without finding a mate */
+    int     species;              /* slot in Simulation.species (set by the simulation on spawn) */
+    int     sickSlot;             /* index in Simulation.sick, -1 = healthy */
+    int     sickUntil;            /* world tick of recovery while sick */
+    int     immuneUntil;          /* world tick immunity ends (0 = never infected) */
     bool    alive;
 } Creature;
 
-/* Initialize creature at position with traits derived from genome */
+/* Level of detail for creature rendering, picked from camera zoom */
+typedef enum {
+    CREATURE_LOD_POINT = 0,  /* flat quad of at least ~1 screen px (batched by the caller) */
+    CREATURE_LOD_BODY,       /* body circle + heading line */
+    CREATURE_LOD_FULL        /* plus FOV sector and body outline */
+} CreatureLOD;
+
+/* Initialize creature at position with traits derived from genome.
+   The genome is referenced, not copied — it must outlive the creature. */
 void CreatureInit(Creature *c, int id, Vector2 pos, const Genome *genome);
 
-/* Apply NN outputs to velocity, wrap toroidally, drain energy, age */
+/* Apply NN outputs to velocity, wrap toroidally, drain energy, age, tick cooldowns */
 void CreatureUpdate(Creature *c, float dt, int worldW, int worldH);
 
-/* Draw body circle, direction line, FOV cone, energy indicator */
-void CreatureDraw(const Creature *c);
+/* Draw body circle and direction line colored by energy, with an orange outline
+   on hunters and a purple ring on the sick; FOV cone and plain outline only at
+   CREATURE_LOD_FULL.
+   Not for CREATURE_LOD_POINT — use CreatureDrawPoint. */
+void CreatureDraw(const Creature *c, CreatureLOD lod);
+
+/* Emit one energy-colored quad (side = max(body diameter, minSize)).
+   Must be called between rlBegin(RL_QUADS) and rlEnd(). */
+void CreatureDrawPoint(const Creature *c, float minSize);
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "config.h"
+#include "creature.h"
+
+/* Spatial domain decomposition of the toroidal world into horizontal bands
+   of grid rows (up to DOMAIN_STRIPS). Each strip is one unit of parallel work.
+
+   Ownership follows position: DomainAssign() buckets alive creatures by the
+   strip their current grid row falls in, so a creature that crossed a strip
+   boundary is handed off to its new owner the next time it is called.
+   Reads of neighbouring strips (the halo) are exact because phases never
+   write shared state that another strip reads in the same phase. */
+typedef struct {
+    int            gridRows;
+    int            stripCount;               /* even, or 1 for worlds under 4 rows */
+    int            cap;                      /* allocated length of order/stripOf */
+    int           *order;                    /* alive creature indices grouped by strip, ascending within a strip */
+    unsigned char *stripOf;                  /* owning strip per creature slot (scratch) */
+    int            start[DOMAIN_STRIPS + 1]; /* strip k owns order[start[k] .. start[k+1]) */
+} Domain;
+
+/* Per-creature callback; strip identifies the owning strip (for per-strip accumulators) */
+typedef void (*DomainCreatureFn)(void *ctx, int strip, int creatureIdx);
+
+/* Pick the strip layout for a world of gridRows rows; no creatures assigned yet */
+void DomainInit(Domain *d, int gridRows);
+
+/* Release the heap-backed index arrays */
+void DomainFree(Domain *d);
+
+/* Strip that owns grid row `row` (0..gridRows-1) */
+int DomainStripOfRow(const Domain *d, int row);
+
+/* Rebuild strip ownership from current creature positions — O(n) counting sort */
+void DomainAssign(Domain *d, const Creature *creatures, int creatureCount);
+
+/* Run fn for every assigned creature, all strips concurrently.
+   fn may only write state owned by its own creature. */
+void DomainForEach(const Domain *d, DomainCreatureFn fn, void *ctx);
+
+/* Run fn for every assigned creature in two colors: even strips concurrently,
+   then odd strips. fn may write grid cells within one row of its creature's
+   row — adjacent strips never run at the same time, so those writes are race-free. */
+void DomainForEachColored(const Domain *d, DomainCreatureFn fn, void *ctx);
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdbool.h>
+
+/* Where plants grow: a relative spawn weight per map cell, sampled through
+   a Walker alias table so each spawn is O(1) however many cells there are.
+   A map cell is one grid cell, or in worlds of more than FERTILITY_MAX_CELLS
+   grid cells a block × block square of them (clipped at the world edge),
+   so the map's memory is capped rather than growing with the world. The
+   table is rebuilt (O(map cells)) on the first sample after the weights
+   change, never per spawn. */
+typedef struct {
+    int       gridCols;   /* world grid the map covers */
+    int       gridRows;
+    int       block;      /* grid cells per map cell edge, 1 unless the grid is huge */
+    int       cols;       /* map cells: gridCols / block rounded up */
+    int       rows;
+    float    *weight;     /* relative plant spawn weight, ≥ 0      [cols*rows] */
+    float    *aliasProb;  /* chance of keeping the drawn cell      [cols*rows] */
+    int      *alias;      /* cell taken otherwise                  [cols*rows] */
+    bool      stale;      /* weights changed since the table was built */
+    unsigned  version;    /* bumped on every weight change — for render caches */
+} FertilityMap;
+
+/* Allocate a uniform (flat) map over gridCols × gridRows grid cells */
+void FertilityInit(FertilityMap *m, int gridCols, int gridRows);
+void FertilityFree(FertilityMap *m);
+
+/* Fill with fertile patches and barren stretches from tileable value noise,
+   drawn from the raylib RNG (reproducible under SetRandomSeed) */
+void FertilityGenerate(FertilityMap *m);
+
+/* Fill from the brightness of an image stretched over the grid (bright =
+   fertile). Returns false and leaves the map unchanged if it can't be loaded. */
+bool FertilityLoadImage(FertilityMap *m, const char *path);
+
+/* Change one map cell's weight */
+void FertilitySet(FertilityMap *m, int cell, float weight);
+
+/* Draw a grid cell with probability proportional to the weight of its map
+   cell (uniform if all weights are zero) */
+int FertilitySample(FertilityMap *m);
@@ -2,6 +2,8 @@
 
 #include "config.h"
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 /* ── Activation function enum ────────────────────────────────── */
 typedef enum {
@@ -16,14 +18,31 @@ typedef enum {
     ACT_COUNT
 } ActivationFunc;
 
+/* ── Packed, variable-length encoding ────────────────────────── */
+/*    Genomes are stored packed — in the genome pool arena,       */
+/*    species representatives and checkpoints: byte node ids,     */
+/*    Q2.13 fixed-point weights, 32-bit node markings and 3-bit   */
+/*    activation codes, with exactly connCount connections and    */
+/*    hiddenCount markings and codes after the fixed header. Use the accessors below; GenomeEvalNN     */
+/*    dequantizes as it goes.                                     */
+#define NN_WEIGHT_MAX     4.0f                /* weights clamp to [-4, 4) */
+#define NN_WEIGHT_SCALE   8192.0f             /* fixed-point steps per unit weight */
+#define NN_ACT_BITS       3
+
+_Static_assert(NN_NODE_COUNT <= 256, "node ids must fit in a byte");
+_Static_assert(NN_HIDDEN_LIMIT <= 65535, "hiddenCount is 16-bit");
+_Static_assert(ACT_COUNT <= (1 << NN_ACT_BITS), "activation codes must fit in NN_ACT_BITS");
+
 /* ── Connection between two nodes in the neural network ──────── */
 typedef struct {
-    int   from;    /* source node index (global: 0..NN_NODE_COUNT-1) */
-    int   to;      /* destination node index */
-    float weight;  /* connection weight [-4, 4] */
+    uint8_t from;    /* source node index (global: 0..NN_NODE_COUNT-1) */
+    uint8_t to;      /* destination node index */
+    int16_t weight;  /* fixed point: weight × NN_WEIGHT_SCALE — see NNConnWeight */
 } NNConn;
 
 /* ── Genome — physical traits + dynamic NN topology ─────────── */
+/*    Variable-length: never declare one by value or copy it with */
+/*    `=`; sizes come from GenomeSize / GenomeBytes.              */
 typedef struct {
     /* Physical traits (stored directly, not as gene indices) */
     float          size;         /* body radius px [3, 12] */
@@ -33,38 +52,177 @@ typedef struct {
     float          metabolism;   /* base energy drain per second [1, 8] */
     float          lifespan;     /* max age in seconds [60, 600] */
     float          mutationRate; /* per-trait mutation probability [0.005, 0.5] */
+    float          rays;         /* vision ray count, rounded [1, SENSE_RAYS_MAX] (--sensors rays) */
+    float          carnivory;    /* diet: 0 = plants only, 1 = meat only [0, 1] */
 
     /* Network topology */
-    int            hiddenCount;                 /* 0..NN_HIDDEN_MAX active hidden nodes */
-    ActivationFunc hiddenAct[NN_HIDDEN_MAX];   /* activation per hidden slot */
-    int            connCount;                   /* 0..NN_CONN_MAX active connections */
-    NNConn         conns[NN_CONN_MAX];          /* connection list */
+    uint16_t       hiddenCount;  /* 0..NN_HIDDEN_LIMIT active hidden nodes */
+    uint16_t       connCount;    /* 0..NN_CONN_LIMIT active connections */
+    NNConn         conns[];      /* connCount connections grouped by target node (ascending
+                                    `to`, creation order within a node), then
+                                    hiddenCount node markings (GenomeMarks) and
+                                    GenomeActBytes(hiddenCount) bytes of 3-bit
+                                    activation codes — see GenomeHiddenAct */
 } Genome;
 
-/* Initialize genome with random traits and sparse input→output connections (hiddenCount=0) */
-void GenomeRandom(Genome *g);
+/* Bytes of packed activation codes for n hidden nodes (+1: 16-bit reads stay in bounds) */
+static inline size_t GenomeActBytes(int hiddenCount) {
+    return (size_t)(hiddenCount * NN_ACT_BITS + 7) / 8 + 1;
+}
+
+/* Bytes after the connections: node markings, then activation codes */
+static inline size_t GenomeTailBytes(int hiddenCount) {
+    return (size_t)hiddenCount * sizeof(uint32_t) + GenomeActBytes(hiddenCount);
+}
+
+/* Total bytes of a genome with the given topology size */
+static inline size_t GenomeBytes(int hiddenCount, int connCount) {
+    return sizeof(Genome) + (size_t)connCount * sizeof(NNConn) + GenomeTailBytes(hiddenCount);
+}
+
+static inline size_t GenomeSize(const Genome *g) {
+    return GenomeBytes(g->hiddenCount, g->connCount);
+}
+
+/* Historical node markings. Node ids are positional (hidden nodes in the
+   order a lineage added them), so two lineages give the same id to
+   unrelated nodes. Each hidden node therefore also carries a marking: the
+   first split of a connection in a run draws a fresh one, and every later
+   split of a connection with the same innovation number, in any genome,
+   reuses it — NEAT's innovation registry. Inputs and outputs have fixed
+   markings below NN_MARK_HIDDEN_BASE. */
+#define NN_MARK_HIDDEN_BASE  (NN_INPUTS + NN_OUTPUTS)
+
+/* Node markings of hidden slots 0..hiddenCount-1, stored right after the connections */
+static inline const uint32_t *GenomeMarks(const Genome *g) {
+    return (const uint32_t *)(g->conns + g->connCount);
+}
+
+/* Marking of node id `node` in g */
+static inline uint32_t GenomeNodeMark(const Genome *g, int node) {
+    if (node < NN_NODE_HIDDEN_BASE) return (uint32_t)node;
+    if (node >= NN_NODE_OUT_BASE)   return (uint32_t)(NN_INPUTS + node - NN_NODE_OUT_BASE);
+    return GenomeMarks(g)[node - NN_NODE_HIDDEN_BASE];
+}
+
+/* Innovation number of connection c of g: the markings of its endpoints.
+   Genomes descended from the same link or split carry the same number for
+   it; crossover and SpeciesDistance align connections by it. */
+static inline uint64_t NNConnInnovation(const Genome *g, const NNConn *c) {
+    return (uint64_t)GenomeNodeMark(g, c->from) << 32 | GenomeNodeMark(g, c->to);
+}
+
+/* Dequantize a connection weight */
+static inline float NNConnWeight(const NNConn *c) {
+    return (float)c->weight * (1.0f / NN_WEIGHT_SCALE);
+}
+
+/* Quantize a weight to fixed point, clamping to [-NN_WEIGHT_MAX, NN_WEIGHT_MAX) */
+static inline int16_t NNWeightPack(float w) {
+    float q = w * NN_WEIGHT_SCALE;
+    q = q >  32767.0f ?  32767.0f : q;
+    q = q < -32768.0f ? -32768.0f : q;
+    return (int16_t)(q >= 0.0f ? q + 0.5f : q - 0.5f);   /* round half away; truncation keeps it in range */
+}
+
+/* Packed activation codes, stored right after the node markings */
+static inline const uint8_t *GenomeActs(const Genome *g) {
+    return (const uint8_t *)(GenomeMarks(g) + g->hiddenCount);
+}
 
-/* Create offspring genome from parent a with mutation applied.
-   b is accepted for API compatibility but ignored (asexual reproduction). */
-void GenomeCrossover(const Genome *a, const Genome *b, Genome *child, float mutationRate);
+/* Activation of hidden slot h */
+static inline ActivationFunc GenomeHiddenAct(const Genome *g, int h) {
+    const uint8_t *acts = GenomeActs(g);
+    int      bit  = h * NN_ACT_BITS;
+    unsigned bits = acts[bit >> 3] | ((unsigned)acts[(bit >> 3) + 1] << 8);
+    return (ActivationFunc)((bits >> (bit & 7)) & ((1u << NN_ACT_BITS) - 1));
+}
 
-/* Evaluate neural network given inputs; fills hidden_out and outputs arrays.
-   hidden_out must be NN_HIDDEN_MAX elements; only [0..hiddenCount-1] are written. */
+static inline void GenomeSetHiddenAct(Genome *g, int h, ActivationFunc act) {
+    uint8_t *acts = (uint8_t *)GenomeActs(g);
+    int      bit  = h * NN_ACT_BITS;
+    unsigned mask = ((1u << NN_ACT_BITS) - 1) << (bit & 7);
+    unsigned bits = acts[bit >> 3] | ((unsigned)acts[(bit >> 3) + 1] << 8);
+    bits = (bits & ~mask) | (((unsigned)act << (bit & 7)) & mask);
+    acts[bit >> 3]       = (uint8_t)bits;
+    acts[(bit >> 3) + 1] = (uint8_t)(bits >> 8);
+}
+
+/* ── Construction and mutation ───────────────────────────────── */
+/*    Genomes are built in a scratch buffer owned by this module; */
+/*    the returned pointer is valid until the next call to        */
+/*    GenomeRandom, GenomeCrossover or GenomeDecode, so store it  */
+/*    (GenomePoolAdd) right away. Main thread only.               */
+
+/* Build a genome with random traits and sparse input→output connections (hiddenCount=0) */
+const Genome *GenomeRandom(void);
+
+/* Create an offspring genome of parents a (the fitter) and b, then mutate it.
+   Connections are aligned by innovation number: each one both parents carry
+   takes either parent's weight at random, the rest come from a, so the child
+   has a's topology. Physical traits and the activations of hidden nodes with
+   the same marking in both parents are picked per gene the same way. Pass b == a for asexual
+   reproduction. Copy-on-write: returns a itself when neither crossover nor
+   mutation changed anything, otherwise the child in the scratch buffer. */
+const Genome *GenomeCrossover(const Genome *a, const Genome *b, float mutationRate);
+
+/* Evaluate neural network given inputs; fills outputs and, unless NULL,
+   hidden_out[0..hiddenCount-1]. One pass over the connections, which are
+   grouped by target node. Thread-safe. */
 void GenomeEvalNN(const Genome *g, const float inputs[NN_INPUTS],
-                  float hidden_out[NN_HIDDEN_MAX], float outputs[NN_OUTPUTS]);
+                  float *hidden_out, float outputs[NN_OUTPUTS]);
+
+/* Re-seed the mutation random source from raylib's generator and start a
+   new innovation registry. Call after SetRandomSeed to restart a
+   reproducible run. */
+void GenomeReseed(void);
 
 /* Return human-readable name string for an activation function */
 const char *ActivationFuncName(ActivationFunc f);
 
 /* ── Genome serialization ────────────────────────────────────── */
 
-/* Maximum hex string length (null-terminated) for a fully packed genome */
-#define GENOME_HEX_MAX  580
+/* Serialized layout: the 9 physical traits as little-endian IEEE floats in
+   Genome field order (size, speed, vision, visionAngle, metabolism,
+   lifespan, mutationRate, rays, then carnivory as float 8), hiddenCount and
+   connCount as little-endian 16-bit, the activation bytes, 4 bytes per
+   connection (from, to, weight little-endian), then the hidden node
+   markings as little-endian 32-bit. Strings without the markings (written
+   before they existed) still decode; their hidden nodes get fresh ones. */
+#define GENOME_TRAIT_FLOATS  9
+
+/* Hex string length (including the terminator) GenomeEncode needs for g */
+int GenomeHexSize(const Genome *g);
 
 /* Encode genome to an uppercase hex string.
-   buf must be at least GENOME_HEX_MAX bytes. */
+   buf must be at least GenomeHexSize(g) bytes (smaller → empty string). */
 void GenomeEncode(const Genome *g, char *buf, int bufSize);
 
-/* Decode a hex string produced by GenomeEncode back into a genome.
-   Returns true on success, false if the string is malformed. */
-bool GenomeDecode(const char *hex, Genome *g);
+/* Decode a hex string produced by GenomeEncode into the scratch buffer
+   (see above). Returns NULL if the string is malformed. */
+const Genome *GenomeDecode(const char *hex);
+
+/* ── Gene index ──────────────────────────────────────────────── */
+/*    Aligns the genes of two genomes by a 64-bit key (innovation  */
+/*    number or node marking): one genome's genes are filed, the   */
+/*    other's looked up. Open addressing sized for the largest     */
+/*    genome; each entry is stamped with the fill it belongs to,   */
+/*    so clearing is O(1). Large — keep one static per module.     */
+#define GENE_INDEX_SLOTS  (1 << 17)
+_Static_assert(GENE_INDEX_SLOTS >= 2 * NN_CONN_LIMIT, "gene index must stay at most half full");
+
+typedef struct {
+    uint64_t key[GENE_INDEX_SLOTS];
+    unsigned stampOf[GENE_INDEX_SLOTS];
+    int      value[GENE_INDEX_SLOTS];
+    unsigned stamp;
+} GeneIndex;
+
+/* Forget every entry */
+void GeneIndexClear(GeneIndex *x);
+
+/* File value under key, replacing any value filed under it before */
+void GeneIndexPut(GeneIndex *x, uint64_t key, int value);
+
+/* Value filed under key since the last clear, or -1 */
+int GeneIndexGet(const GeneIndex *x, uint64_t key);
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "genome.h"
+
+/* Slab arena size classes: class k holds genomes of up to
+   GENOME_POOL_MIN_SLOT << k bytes. A typical genome (0–2 hidden nodes,
+   ~20 connections) fits the smallest classes; big networks take bigger slots
+   without costing the small ones anything. */
+#define GENOME_POOL_MIN_SLOT     64
+#define GENOME_POOL_CLASSES      16           /* 64 B .. 2 MB slots — enough for NN_CONN_LIMIT */
+#define GENOME_POOL_SLAB_BYTES   (64 * 1024)  /* slab size; classes with bigger slots get one per slab */
+
+/* One size class: slabs of equal slots carved front to back, with released
+   slots kept on an intrusive free list. Slabs are never moved, so Genome
+   pointers handed out by the pool stay valid while their handle is referenced. */
+typedef struct {
+    unsigned char **slabs;
+    int             slabCount;
+    int             slotsUsed;   /* slots carved from the newest slab */
+    void           *freeList;    /* released slots, linked through their first bytes */
+} GenomeSizeClass;
+
+/* Refcounted store of immutable genomes shared between creatures.
+   A child whose mutation pass changed nothing shares its parent's handle;
+   equal handles therefore mean identical genomes. */
+typedef struct {
+    GenomeSizeClass classes[GENOME_POOL_CLASSES];
+    Genome        **genomes;     /* slot per handle          [cap] */
+    unsigned char  *sizeClass;   /* size class per handle    [cap] */
+    int            *refs;        /* reference count per handle [cap] */
+    int             cap;
+    int             count;       /* handles in use, including released ones awaiting reuse */
+    int            *freeSlots;   /* released handles ready for reuse */
+    int             freeCount;
+    int             live;        /* handles with refs > 0 */
+    size_t          liveBytes;   /* slot bytes held by live handles */
+} GenomePool;
+
+void GenomePoolInit(GenomePool *p);
+void GenomePoolFree(GenomePool *p);
+
+/* Store a copy of *g (GenomeSize(g) bytes) and return its handle, holding one reference */
+int GenomePoolAdd(GenomePool *p, const Genome *g);
+
+/* Add / drop one reference; the handle and its slot are recycled when the count hits zero */
+void GenomePoolRetain(GenomePool *p, int handle);
+void GenomePoolRelease(GenomePool *p, int handle);
+
+/* Stable pointer to the genome behind a referenced handle */
+const Genome *GenomePoolGet(const GenomePool *p, int handle);
@@ -1,19 +1,60 @@
 #pragma once
 
 #include "config.h"
+#include "popstats.h"
 
-#define HISTORY_LEN          2000
 #define HISTORY_SAMPLE_TICKS  10   /* record one sample every N ticks */
 
-/* Ring buffer of population and trait history for line charts */
+/* Round-robin database of history: tier 0 holds raw samples, and every
+   HISTORY_DECIMATION buckets of tier k are merged into one min/mean/max
+   bucket of tier k+1. Each tier is a ring of HISTORY_TIER_LEN buckets, so
+   memory is constant while tier k spans HISTORY_TIER_LEN × DECIMATION^k
+   samples (tier 4 ≈ 4 days of sim time at 60 Hz). */
+#define HISTORY_TIER_LEN     512
+#define HISTORY_TIERS          5
+#define HISTORY_DECIMATION     8
+
+/* Series recorded into the history: counts, then the population mean of
+   each Trait (series HIST_TRAIT_MEAN + t) */
+typedef enum {
+    HIST_POPULATION = 0,
+    HIST_FOOD,
+    HIST_SPECIES,        /* living species */
+    HIST_TRAIT_MEAN,
+    HIST_SERIES_COUNT = HIST_TRAIT_MEAN + TRAIT_COUNT
+} HistorySeries;
+
+/* Aggregate of one or more consecutive samples */
+typedef struct {
+    float min;
+    float mean;
+    float max;
+} HistoryBucket;
+
+/* One resolution level: a ring of buckets per series, plus the bucket being
+   accumulated for the next tier up */
 typedef struct {
-    int   population[HISTORY_LEN];
-    int   food[HISTORY_LEN];
-    float avgSpeed[HISTORY_LEN];
-    float avgMetabolism[HISTORY_LEN];
-    int   head;    /* index of next write position */
-    int   count;   /* number of valid samples (0..HISTORY_LEN) */
+    HistoryBucket data[HIST_SERIES_COUNT][HISTORY_TIER_LEN];
+    int           head;                     /* index of next write position */
+    int           count;                    /* number of valid buckets (0..HISTORY_TIER_LEN) */
+    HistoryBucket pending[HIST_SERIES_COUNT]; /* partial bucket for tier+1 (mean holds the sum) */
+    int           pendingCount;             /* buckets merged into pending so far */
+} HistoryTier;
+
+/* Multi-resolution population and trait history for line charts */
+typedef struct {
+    HistoryTier tiers[HISTORY_TIERS];
+    long long   samples;                    /* total samples ever recorded */
 } History;
 
-/* Record one sample; advances head with modulo wrap, increments count up to HISTORY_LEN */
-void HistoryRecord(History *h, int population, int food, float avgSpeed, float avgMetabolism);
+/* Record one sample (one value per HistorySeries) into tier 0 and cascade
+   completed buckets into coarser tiers — O(HISTORY_TIERS) worst case */
+void HistoryRecord(History *h, const float values[HIST_SERIES_COUNT]);
+
+/* Finest tier whose ring still holds the whole run, or the coarsest tier
+   once even that has wrapped. Its bucket count never exceeds HISTORY_TIER_LEN,
+   so charts drawn from it have constant cost regardless of run length. */
+int HistoryChartTier(const History *h);
+
+/* Largest bucket max of one series within the chart tier — for autoscaling */
+float HistoryChartMax(const History *h, HistorySeries series);
@@ -2,6 +2,6 @@
 
 #include "creature.h"
 
-/* Draw the neural network inspector overlay for the selected creature.
-   Call in screen-space (outside BeginMode2D). */
-void NNViewDraw(const Creature *c);
+/* Draw the neural network inspector overlay for the selected creature;
+   sensors picks the input labels. Call in screen-space (outside BeginMode2D). */
+void NNViewDraw(const Creature *c, SensorMode sensors);
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "genome.h"
+
+/* Histogram bins per trait — also the resolution of the quantile sketch */
+#define POPSTATS_BINS  64
+
+/* Genome traits tracked by the population statistics */
+typedef enum {
+    TRAIT_SIZE = 0,
+    TRAIT_SPEED,
+    TRAIT_VISION,
+    TRAIT_VISION_ANGLE,
+    TRAIT_METABOLISM,
+    TRAIT_LIFESPAN,
+    TRAIT_MUTATION_RATE,
+    TRAIT_RAYS,
+    TRAIT_CARNIVORY,
+    TRAIT_HIDDEN_COUNT,
+    TRAIT_CONN_COUNT,
+    TRAIT_COUNT
+} Trait;
+
+/* Running sums plus a fixed-range histogram for one trait. The histogram
+   doubles as the quantile sketch: unlike GK/t-digest it supports removal,
+   and its error is bounded by one bin width. */
+typedef struct {
+    double sum;
+    double sumSq;
+    int    bins[POPSTATS_BINS];
+} TraitStats;
+
+/* Statistics over the living population, maintained on birth and death */
+typedef struct {
+    int        count;               /* creatures currently accounted for */
+    TraitStats traits[TRAIT_COUNT];
+} PopStats;
+
+/* Account for a newborn genome — O(TRAIT_COUNT) */
+void PopStatsAdd(PopStats *p, const Genome *g);
+
+/* Remove a dead creature's genome — must be the same genome passed to Add */
+void PopStatsRemove(PopStats *p, const Genome *g);
+
+float PopStatsMean(const PopStats *p, Trait t);
+float PopStatsStdDev(const PopStats *p, Trait t);
+
+/* Approximate q-quantile (q in [0,1]), interpolated within the bin that
+   holds it — O(POPSTATS_BINS). Returns 0 for an empty population. */
+float PopStatsQuantile(const PopStats *p, Trait t, float q);
+
+/* Histogram range [*lo, *hi] of trait t; values outside fall in the end bins */
+void TraitRange(Trait t, float *lo, float *hi);
+
+/* Short display name of trait t */
+const char *TraitName(Trait t);
@@ -0,0 +1,14 @@
+#pragma once
+
+/* Bulk uniform random source for genome construction and mutation: eight
+   xoshiro128+ streams stepped in lockstep, seeded once from raylib's
+   generator so SetRandomSeed still pins a run. Main thread only. */
+
+/* Fill out[0..n) with uniform floats in [0, 1) */
+void RngUniforms(float *out, int n);
+
+/* Uniform random float in [0, 1) */
+float RngFloat(void);
+
+/* Drop the current state so the next draw re-seeds from raylib's generator */
+void RngReseed(void);
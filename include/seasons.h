@@ -0,0 +1,14 @@
+#pragma once
+
+/* Seasonal food supply: a fixed yearly cycle of SEASON_COUNT seasons, each
+   SEASON_TICKS long, scaling the food sliders while seasons are on */
+typedef struct {
+    const char *name;
+    float       foodRateMult;    /* × SimSettings.foodSpawnRate */
+    float       foodTargetMult;  /* × SimSettings.foodTarget (plant cap) */
+} Season;
+
+#define SEASON_COUNT 4
+
+/* Season in effect at world tick `tick` */
+const Season *SeasonAt(int tick);
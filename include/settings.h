@@ -10,7 +10,45 @@ typedef struct {
     float foodSpawnRate;  /* food items spawned per second */
     float mutRateMult;    /* multiplier on genome mutation rate */
     int   minPopulation;  /* respawn floor: keep at least this many creatures alive */
+    int   chartTrait;     /* Trait shown in the trait chart and histogram */
+    bool  staggerSensing; /* adapt senseCohorts to the frame budget (otherwise K = 1) */
+    int   senseCohorts;   /* K: each creature re-queries the grids every K ticks */
+    float simFrameTime;   /* smoothed seconds of simulation per frame */
+    bool  collisions;     /* push overlapping bodies apart (SEPARATION_STIFFNESS) */
+    bool  sexual;         /* pair ready creatures with a mate (otherwise asexual cloning) */
+    bool  seasons;        /* scale food spawn rate and cap by the season (seasons.h) */
+    bool  outbreaks;      /* spontaneous disease outbreaks (DISEASE_OUTBREAK_RATE) */
+    int   outbreakSeeds;  /* UI request: infect this many creatures before the next update */
 } SimSettings;
 
 /* Fill *s with safe defaults */
 void SimSettingsDefault(SimSettings *s);
+
+/* Feed the time spent in SimulationUpdate this frame; when staggered sensing
+   is on, doubles or halves senseCohorts to keep it near SENSE_FRAME_BUDGET */
+void SimSettingsAdaptSensing(SimSettings *s, float simSeconds);
+
+/* Startup parameters, fixed for the lifetime of a run (command-line flags) */
+typedef struct {
+    int worldWidth;    /* px, rounded up to a multiple of GRID_CELL_SIZE */
+    int worldHeight;   /* px, rounded up to a multiple of GRID_CELL_SIZE */
+    int maxCreatures;  /* population cap — the creature pool grows up to this */
+    int maxFood;       /* food pool cap — the food pool grows up to this */
+    int threads;       /* worker threads including the main thread, 0 = all cores */
+    int activations;   /* ActivationMode: 0 = exact libm, 1 = fast approximations */
+    int sensors;       /* SensorMode: 0 = k-nearest in cone, 1 = raycast */
+    int grid;          /* CellTableMode of the food and creature grids: 0 = auto, 1 = dense, 2 = hashed */
+    const char *fertility;  /* plant spawn map: "noise", "flat" or an image path (see WorldInit) */
+    bool activationReport;  /* print the activation error/benchmark report and exit */
+    int benchmarkTicks;     /* > 0: run the headless benchmark for this many ticks and exit */
+} SimParams;
+
+/* Fill *p with the compile-time defaults from config.h */
+void SimParamsDefault(SimParams *p);
+
+/* Parse --world-width N, --world-height N, --max-creatures N, --max-food N,
+   --threads N, --activations exact|fast, --sensors cone|rays, --grid auto|dense|hash,
+   --fertility noise|flat|FILE, --activation-report and --benchmark TICKS
+   into *p (fertility points into argv).
+   Prints usage and returns false on unknown flags or bad values. */
+bool SimParamsParseArgs(SimParams *p, int argc, char **argv);
@@ -1,22 +1,93 @@
 #pragma once
 
 #include "world.h"
+#include "world_layers.h"
 #include "creature.h"
+#include "domain.h"
 #include "history.h"
+#include "popstats.h"
+#include "species.h"
+#include "genome_pool.h"
 #include "settings.h"
+#include "seasons.h"
 
+/* Verlet neighbour list of one creature: every other creature within
+   vision + NBR_SKIN of buildPos when it was built (a superset of what the
+   creature can sense until the list expires — see config.h) */
 typedef struct {
-    World    world;
-    Creature creatures[MAX_CREATURES];
-    int      creatureCount;
-    int      nextId;
-    int      totalDeaths;
-    int      totalBirths;
-    int      aliveCount;   /* cached alive creature count — updated incrementally */
-    History  history;
+    int      *idx;
+    int       count;
+    int       cap;
+    Vector2   buildPos;
+    float     age;        /* seconds since the build */
+    unsigned  birthSeq;   /* Simulation.birthSeq at the build */
+    unsigned  bornSeq;    /* Simulation.birthSeq when this slot's creature spawned */
+    double    pushMark;   /* Simulation.pushTravel at the build */
+    bool      valid;      /* false for newborns until their first build */
+} NbrList;
+
+typedef struct {
+    World     world;
+    Creature *creatures;      /* heap pool of creatureCap slots, grows geometrically */
+    int       creatureCap;    /* allocated slots in creatures and the per-slot arrays below */
+    int       maxCreatures;   /* population cap (runtime parameter) */
+    int       creatureCount;  /* slots in use, including dead ones awaiting reuse */
+    int      *freeSlots;      /* stack of dead slots ready for reuse */
+    int       freeCount;
+    int       nextId;
+    int       totalDeaths;
+    int       totalBirths;
+    int       totalKills;   /* deaths by predation (also counted in totalDeaths) */
+    int       sexualBirths; /* births from a mated pair (also counted in totalBirths) */
+    int       aliveCount;   /* cached alive creature count — updated incrementally */
+    float     maxVision;    /* upper bound on any creature's vision — draw culling margin */
+    float     maxSpeed;     /* upper bound on any creature's speed — neighbour list expiry */
+    SensorMode sensors;     /* sensor model for the whole run (SimParams.sensors) */
+    History   history;
+    PopStats  stats;        /* trait sums + histograms of the living — updated on birth/death */
+    SpeciesTable species;   /* NEAT species registry — assigned on birth, released on death */
+    GenomePool   genomes;   /* refcounted shared genomes — one reference per creature */
+
+    /* Creature spatial grid — persistent: relinked on cell crossings, births, deaths */
+    SpatialGrid crGrid;
+    int      *crossed;      /* creatures that changed cell this tick, by strip [creatureCap] */
+    int      *eatenFood;    /* food items eaten this tick, by strip  [creatureCap]       */
+
+    /* Verlet neighbour lists, reused by every creature–creature query */
+    NbrList  *nbr;          /* per creature slot                     [creatureCap]       */
+    int      *birthLog;     /* ring of slots spawned, indexed by birthSeq [NBR_BIRTH_LOG] */
+    unsigned  birthSeq;     /* creatures spawned so far                                  */
+
+    /* Contact phase (bodies touching): separation, predation and mate choice */
+    int      *preyOf;       /* creature i's chosen prey this tick, -1 = none [creatureCap] */
+    int      *claimedBy;    /* winning attacker of each prey, -1 = none      [creatureCap] */
+    int      *mateOf;       /* creature i's chosen mate this tick, -1 = none [creatureCap] */
+    float    *pushX;        /* creature i's separation push this tick, px    [creatureCap] */
+    float    *pushY;        /*                                               [creatureCap] */
+    double    pushTravel;   /* running sum of each tick's largest push — how far separation
+                               may have shoved any creature (neighbour list expiry) */
+    int       contacts;     /* touching pairs seen last tick (each pair counted from both sides) */
+    float     contactTime;  /* wall-clock seconds the last contact phase took */
+
+    /* Disease: only the sick are visited each tick */
+    int      *sick;         /* slots of sick creatures, dense  [creatureCap] */
+    int       sickCount;
+    int       totalInfections;
+    Domain    domain;       /* strip decomposition for the parallel phases */
 } Simulation;
 
-void SimulationInit(Simulation *s);
+/* Allocate pools and grids sized from *params and spawn the initial population */
+void SimulationInit(Simulation *s, const SimParams *params);
+/* Release everything SimulationInit allocated */
+void SimulationFree(Simulation *s);
 void SimulationUpdate(Simulation *s, float dt, const SimSettings *settings);
-void SimulationDraw(const Simulation *s);
+/* Draw the world and creatures overlapping `view` (world-space rectangle
+   visible through the camera), with level of detail picked from `zoom`.
+   layers may be NULL to draw the world without cached render textures. */
+void SimulationDraw(const Simulation *s, const WorldLayers *layers, Rectangle view, float zoom);
 int  SimulationAliveCount(const Simulation *s);
+/* Living creature nearest to pos closer than radius, -1 if none */
+int  SimulationPick(const Simulation *s, Vector2 pos, float radius);
+/* Infect up to `count` random living creatures that are neither sick nor
+   immune (patient zeros for an outbreak) */
+void SimulationInfect(Simulation *s, int count);
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "raylib.h"
+#include "config.h"
+#include "cell_table.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Shortest signed offset along one axis of the toroidal world */
+#define TORUS_DELTA(val, dim) \
+    ((val) >  (dim)*0.5f ? (val)-(dim) : (val) < -(dim)*0.5f ? (val)+(dim) : (val))
+
+/* Uniform grid of GRID_CELL_SIZE cells over the toroidal world, indexing the
+   items of one pool (food, creatures) by position. Each cell holds a linked
+   list of item slots: heads in a CellTable (dense or hashed), links per item.
+   The owner keeps the items and their positions; the grid reads positions
+   through a strided binding, refreshed with SpatialBind whenever the pool
+   moves. Every proximity query in the simulation, the renderer and mouse
+   picking goes through here. */
+typedef struct {
+    CellTable   heads;      /* first item per cell, -1 = empty                  */
+    int        *next;       /* next item in the same cell, -1 = end      [cap]  */
+    int        *cell;       /* cell the item was last linked in, -1 = never [cap] */
+    int         cap;
+    int         cols;
+    int         rows;
+    float       width;      /* world size in px */
+    float       height;
+    const char *pos;        /* Vector2 position of item 0 ...                   */
+    size_t      posStride;  /* ... and the byte distance between items          */
+} SpatialGrid;
+
+/* View cone: directions within halfAngle of facing (radians) */
+typedef struct {
+    float facing;
+    float halfAngle;
+} SpatialCone;
+
+/* Bounded max-heap of the k nearest candidates seen so far. Once full, its
+   root is the distance a new candidate has to beat, so most candidates are
+   rejected by one compare. Set k (≤ SPATIAL_NEAREST_MAX), leave n = 0. */
+#define SPATIAL_NEAREST_MAX  8
+typedef struct {
+    int   k, n;
+    float dSq[SPATIAL_NEAREST_MAX];
+    int   idx[SPATIAL_NEAREST_MAX];
+} SpatialNearest;
+
+/* Visitor for radius queries: item, its offset from the query point on the
+   torus and the squared distance. Return true to stop the query. */
+typedef bool (*SpatialVisitFn)(void *ctx, int item, float dx, float dy, float dSq);
+
+/* Visitor for rect queries */
+typedef void (*SpatialItemFn)(void *ctx, int item);
+
+/* Set up an empty grid over a width × height world (multiples of
+   GRID_CELL_SIZE) for a pool of up to maxItems; mode picks the head layout */
+void SpatialInit(SpatialGrid *g, int width, int height, int maxItems, CellTableMode mode);
+void SpatialFree(SpatialGrid *g);
+
+/* Grow the per-item links to cap slots (new slots unlinked) */
+void SpatialReserve(SpatialGrid *g, int cap);
+
+/* Point the grid at the owner's positions: item i is at
+   *(const Vector2 *)((const char *)first + i * stride) */
+void SpatialBind(SpatialGrid *g, const Vector2 *first, size_t stride);
+
+static inline Vector2 SpatialPos(const SpatialGrid *g, int item) {
+    return *(const Vector2 *)(g->pos + (size_t)item * g->posStride);
+}
+
+/* Cell of a position in [0, width) × [0, height) */
+static inline int SpatialCellOf(const SpatialGrid *g, Vector2 p) {
+    int col = (int)(p.x / GRID_CELL_SIZE) % g->cols;
+    int row = (int)(p.y / GRID_CELL_SIZE) % g->rows;
+    return row * g->cols + col;
+}
+
+/* Cell at a raw column/row, either of which may lie off the world */
+static inline int SpatialCellAt(const SpatialGrid *g, int col, int row) {
+    col = ((col % g->cols) + g->cols) % g->cols;
+    row = ((row % g->rows) + g->rows) % g->rows;
+    return row * g->cols + col;
+}
+
+/* Walk one cell's list: for (i = SpatialHead(g, c); i != -1; i = g->next[i]) */
+static inline int SpatialHead(const SpatialGrid *g, int cell) {
+    return CellTableGet(&g->heads, cell);
+}
+
+/* True once item has left the cell it is linked in */
+static inline bool SpatialMoved(const SpatialGrid *g, int item) {
+    return SpatialCellOf(g, SpatialPos(g, item)) != g->cell[item];
+}
+
+/* Link item into the cell of its current position. May file a new cell
+   (see CellTableSet): main thread only. */
+void SpatialInsert(SpatialGrid *g, int item);
+
+/* Unlink item from its cell. Its cell stays recorded for the owner's
+   bookkeeping. Writes only that cell's list, so strip workers may unlink
+   items in cells no other running strip touches. */
+void SpatialUnlink(SpatialGrid *g, int item);
+
+/* Move item to the cell of its current position */
+void SpatialRelink(SpatialGrid *g, int item);
+
+/* True if the offset (dx, dy) points inside cone */
+static inline bool SpatialInCone(const SpatialCone *cone, float dx, float dy) {
+    float angle = atan2f(dy, dx) - cone->facing;
+    while (angle >  PI) angle -= 2.0f * PI;
+    while (angle < -PI) angle += 2.0f * PI;
+    return fabsf(angle) <= cone->halfAngle;
+}
+
+/* Squared distance a candidate must be under to enter the heap */
+static inline float SpatialNearestBound(const SpatialNearest *h, float limitSq) {
+    return h->n < h->k ? limitSq : h->dSq[0];
+}
+
+/* Insert a candidate already known to beat SpatialNearestBound */
+void SpatialNearestPush(SpatialNearest *h, float dSq, int idx);
+
+/* Order the heap contents nearest-first */
+void SpatialNearestSort(SpatialNearest *h);
+
+/* Visit every item closer than radius to pos on the torus (and inside cone
+   unless it is NULL), cell by cell in row-major order from the top-left
+   cell the radius reaches; each cell is visited once however large the
+   radius. Returns true if fn stopped the query. */
+bool SpatialQueryRadius(const SpatialGrid *g, Vector2 pos, float radius, const SpatialCone *cone,
+                        SpatialVisitFn fn, void *ctx);
+
+/* Fill h with the h->k items nearest to pos closer than radius on the torus
+   (and inside cone unless it is NULL), nearest first. Cells are walked in
+   rings outward from pos's own; every point in ring r + 1 is at least r cells
+   away, so the walk stops once the heap is full and its root is nearer. */
+void SpatialQueryNearest(const SpatialGrid *g, Vector2 pos, float radius, const SpatialCone *cone,
+                         SpatialNearest *h);
+
+/* Visit every item positioned inside rect (world px, unwrapped: the part
+   off the world is ignored, as when drawing) */
+void SpatialQueryRect(const SpatialGrid *g, Rectangle rect, SpatialItemFn fn, void *ctx);
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "genome.h"
+
+/* One species: a founding representative genome plus its live member count */
+typedef struct {
+    int      id;        /* monotonically increasing, for display */
+    int      members;   /* living creatures assigned to this species (0 = slot free) */
+    unsigned hash;      /* topology hash of rep */
+    Genome  *rep;       /* representative (heap copy of the founder's genome; kept for slot reuse) */
+} Species;
+
+/* Species registry. Slots of extinct species are recycled; hashes are kept
+   in a separate dense array so the candidate scan touches 4 bytes per species. */
+typedef struct {
+    Species  *list;
+    unsigned *hashes;      /* hashes[i] == list[i].hash */
+    int       count;       /* slots in use, including extinct ones awaiting reuse */
+    int       cap;
+    int      *freeSlots;   /* extinct slots ready for reuse */
+    int       freeCount;
+    int       alive;       /* species with members > 0 */
+    int       nextId;
+} SpeciesTable;
+
+void SpeciesInit(SpeciesTable *t);
+void SpeciesFree(SpeciesTable *t);
+
+/* 32-bit SimHash over the genome's connection innovations and its hidden
+   nodes' markings and activations: genomes that share most of their
+   topology differ in few bits. */
+unsigned SpeciesTopologyHash(const Genome *g);
+
+/* NEAT compatibility distance over topology and weights (see config.h).
+   Main thread only (shares a static GeneIndex). */
+float SpeciesDistance(const Genome *a, const Genome *b);
+
+/* Assign a newborn genome to a species and count it as a member; returns the
+   species slot. The parent's species (or -1) is tried first; otherwise only
+   species whose hash lies within SPECIES_HASH_RADIUS are compared, and a new
+   species is founded when none is compatible. */
+int SpeciesAssign(SpeciesTable *t, const Genome *g, int parentSpecies);
+
+/* Count one more member of an existing species without a compatibility check
+   (for a child whose genome is identical to its parent's) */
+void SpeciesJoin(SpeciesTable *t, int species);
+
+/* Drop one member from species slot `species`; the slot is recycled at zero */
+void SpeciesRelease(SpeciesTable *t, int species);
@@ -0,0 +1,42 @@
+#pragma once
+
+/* Hierarchical timing wheel: TIMER_WHEEL_LEVELS wheels of TIMER_WHEEL_SLOTS
+   slots, level l slots spanning TIMER_WHEEL_SLOTS^l ticks. An item is filed
+   by how far away it is due; when the level-0 cursor wraps, the next level's
+   current slot is cascaded down. Advancing a tick touches only the items
+   that fire (plus each item at most LEVELS-1 times on its way down), never
+   the whole set. */
+#define TIMER_WHEEL_BITS    8
+#define TIMER_WHEEL_SLOTS   (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_LEVELS  3   /* horizon 2^24 ticks (~78 h at 60 ticks/s) */
+
+/* Timers for integer item ids [0, cap) owned by the caller (e.g. pool slots),
+   kept in intrusive doubly linked slot lists so cancelling is O(1) */
+typedef struct {
+    int  head[TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS];  /* slot list heads, -1 = empty */
+    int *next;   /* [cap] */
+    int *prev;   /* [cap] -1 = list head */
+    int *slot;   /* [cap] wheel slot the item is filed in, -1 = not scheduled */
+    int *due;    /* [cap] absolute tick the item fires on */
+    int  cap;
+    int  now;    /* last tick advanced to */
+    int  count;  /* scheduled items */
+} TimerWheel;
+
+/* Start empty at tick `now` with no item slots */
+void TimerWheelInit(TimerWheel *tw, int now);
+void TimerWheelFree(TimerWheel *tw);
+
+/* Make room for item ids [0, cap); new ids start unscheduled */
+void TimerWheelReserve(TimerWheel *tw, int cap);
+
+/* Fire `item` on tick `due` (clamped to [now + 1, now + horizon - 1]),
+   replacing any earlier schedule of the same item */
+void TimerWheelSchedule(TimerWheel *tw, int item, int due);
+
+/* Unschedule `item`; no-op if it is not scheduled */
+void TimerWheelCancel(TimerWheel *tw, int item);
+
+/* Advance one tick and call fire(ctx, item) for every item due on it.
+   Items are unscheduled before their callback, which may reschedule them. */
+void TimerWheelAdvance(TimerWheel *tw, void (*fire)(void *ctx, int item), void *ctx);
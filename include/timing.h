@@ -0,0 +1,5 @@
+#pragma once
+
+/* Wall-clock seconds from an arbitrary origin, for timing phases and
+   benchmarks. Unlike raylib's GetTime it works without a window. */
+double TimingSeconds(void);
@@ -0,0 +1,22 @@
+#pragma once
+
+/* Minimal fixed-size worker pool used to run data-parallel simulation phases.
+   Jobs are identified by index; a phase is one WorkersRun() call that blocks
+   until every job has finished. The calling thread participates, so a pool of
+   one thread (or an uninitialized pool) simply runs all jobs inline. */
+
+typedef void (*WorkerJobFn)(void *ctx, int job);
+
+/* Start the pool. threadCount <= 0 picks the hardware concurrency.
+   The count is clamped to [1, WORKER_THREADS_MAX] and includes the caller. */
+void WorkersInit(int threadCount);
+
+/* Stop and join all worker threads. Safe to call when not initialized. */
+void WorkersShutdown(void);
+
+/* Number of threads that execute jobs (including the calling thread) */
+int WorkersCount(void);
+
+/* Run fn(ctx, job) for every job in [0, jobCount) and wait for completion.
+   Jobs may run concurrently and in any order. */
+void WorkersRun(WorkerJobFn fn, void *ctx, int jobCount);
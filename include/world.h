@@ -2,44 +2,108 @@
 
 #include "raylib.h"
 #include "config.h"
+#include "timer_wheel.h"
+#include "fertility.h"
+#include "spatial.h"
 
-/* A single plant-food item in the world */
+typedef enum {
+    FOOD_PLANT = 0,  /* spawned at random, topped up to foodTarget */
+    FOOD_MEAT        /* left by a dead creature, rots on a timer */
+} FoodKind;
+
+/* A single food item in the world */
 typedef struct {
-    Vector2 position;
-    float   nutrition;
-    bool    eaten;
+    Vector2  position;
+    float    nutrition;
+    FoodKind kind;
+    bool     eaten;
 } Food;
 
 /* Global environment state */
 typedef struct {
     int   width;
     int   height;
-    Food  plants[MAX_FOOD];
+    Food *food;          /* heap pool of foodCap slots, grows geometrically */
+    int   foodCap;       /* allocated slots in food, foodGrid's links and foodFree */
+    int  *foodFree;      /* stack of eaten slots ready for reuse */
+    int   foodFreeCount;
+    int   maxFood;       /* hard cap on foodCap (runtime parameter) */
     float foodSpawnTimer;
     int   tick;
-    int   foodTarget;    /* runtime-adjustable food cap */
+    int   foodTarget;    /* runtime-adjustable plant cap */
     float foodSpawnRate; /* runtime-adjustable spawn rate (items/sec) */
 
-    /* Spatial hash grid — maintained incrementally on spawn/eat.
-       Linked-list buckets: head[cell] = first food index, -1 = empty. */
-    int  foodGridHead[GRID_CELL_COUNT]; /* per-cell list head (-1 = empty)  */
-    int  foodGridNext[MAX_FOOD];        /* next food in same cell (-1 = end) */
-    int  foodGridCell[MAX_FOOD];        /* which cell food[i] belongs to     */
-    int  foodCount;                     /* cached count of uneaten food      */
+    /* gridCols × gridRows cells of GRID_CELL_SIZE px, sized from width/height,
+       shared by the spatial grids, the fertility map and the render layers */
+    int   gridCols;
+    int   gridRows;
+    SpatialGrid foodGrid; /* uneaten food by cell — maintained on spawn/eat */
+    FertilityMap fertility; /* where plants spawn — one weight per grid cell (or block) */
+    int   foodCount;     /* cached count of uneaten food, both kinds */
+    int   meatCount;     /* ... of which meat                  */
+    TimerWheel meatTimers; /* rot time of each meat item, by food slot */
+
+    /* Cells whose food changed since the last WorldClearFoodDirty — lets the
+       renderer patch its cached food layer instead of redrawing everything.
+       Past FOOD_DIRTY_MAX cells the list gives up and flags the whole world,
+       so its memory is fixed whatever the world size. */
+    int       *foodDirtyCells; /* dirty cell indices                 [FOOD_DIRTY_MAX] */
+    CellTable  foodDirtySet;   /* hashed: cell → its index in foodDirtyCells */
+    int        foodDirtyCount;
+    bool       foodDirtyAll;   /* overflowed: any cell may have changed */
 } World;
 
-/* Initialize world and populate up to FOOD_TARGET food items */
-void WorldInit(World *w);
+struct WorldLayers;  /* cached render textures, see world_layers.h */
+
+/* Initialize a width × height world (multiples of GRID_CELL_SIZE) whose food
+   pool may grow up to maxFood items, pick its fertility map and populate up
+   to FOOD_TARGET plants. fertility is NULL or "noise" for a generated map,
+   "flat" for uniform spawning, or an image path (falling back to noise with
+   a warning if it can't be loaded). grid picks the food grid's layout. */
+void WorldInit(World *w, int width, int height, int maxFood, const char *fertility,
+               CellTableMode grid);
 
-/* Advance world: top up food to w->foodTarget, increment tick */
+/* Release the heap-backed food pool and grid */
+void WorldFree(World *w);
+
+/* Advance world: top up plants to w->foodTarget, increment tick, rot the
+   meat that expires on it (O(expiring items), not O(food)) */
 void WorldUpdate(World *w, float dt);
 
 /* Return cached count of currently active (uneaten) food items — O(1) */
 int WorldFoodCount(const World *w);
 
-/* Remove a food item from the spatial grid (call before marking eaten).
-   Also decrements w->foodCount. */
+/* Leave a meat item worth `nutrition` at pos, rotting MEAT_LIFETIME_TICKS
+   from now. Returns false if the food pool is at maxFood. */
+bool WorldDropMeat(World *w, Vector2 pos, float nutrition);
+
+/* Remove a food item from the world: unlink it from the spatial grid, mark
+   it eaten and release its slot (see WorldFoodRelease) */
 void WorldFoodGridRemove(World *w, int foodIdx);
 
-/* Draw world background and all food items */
-void WorldDraw(const World *w);
+/* Unlink a food item from its grid cell only, for the parallel eat pass
+   which touches only its own cells; it marks the item eaten and settles it
+   with WorldFoodRelease afterwards. */
+void WorldFoodGridUnlink(World *w, int foodIdx);
+
+/* Settle an unlinked, eaten item: update counts and dirty tracking, cancel
+   its rot timer and return its slot to the free stack */
+void WorldFoodRelease(World *w, int foodIdx);
+
+/* Record that food in `cell` changed (idempotent until the next clear);
+   past FOOD_DIRTY_MAX cells this sets foodDirtyAll instead */
+void WorldMarkFoodDirty(World *w, int cell);
+
+/* Forget all dirty cells — called by the renderer once it has patched them */
+void WorldClearFoodDirty(World *w);
+
+/* Emit food quads (half-extent `half` px, colored by kind with opacity
+   `alpha`) for every item whose quad overlaps world rectangle `region`
+   (no wrap). Must be called between rlBegin(RL_QUADS) and rlEnd(). */
+void WorldEmitFoodQuads(const World *w, Rectangle region, float half, unsigned char alpha);
+
+/* Draw world background, grid and food items overlapping `view`
+   (world-space rectangle); food quads never shrink below ~1 screen px.
+   With layers, the background comes from the cached cell tile and far-zoom
+   food from the cached food layer; with NULL everything is drawn directly. */
+void WorldDraw(const World *w, const struct WorldLayers *layers, Rectangle view, float zoom);
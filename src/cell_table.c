@@ -0,0 +1,107 @@
+#include "cell_table.h"
+#include "config.h"
+
+#include "raylib.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CELL_TABLE_MIN_CAP  16
+
+/* ── Internal helpers ────────────────────────────────────────── */
+
+static void AllocSlots(CellTable *t, int cap) {
+    t->cap   = cap;
+    t->shift = 32;
+    for (int c = cap; c > 1; c >>= 1) t->shift--;
+    t->used  = 0;
+    t->slot  = malloc((size_t)cap * sizeof(*t->slot));
+    if (!t->slot) TraceLog(LOG_FATAL, "CELLS: out of memory allocating %d hashed cells", cap);
+    for (int s = 0; s < cap; s++) t->slot[s] = (CellTableEntry){ -1, -1 };
+}
+
+/* Free slot for a cell known not to be filed */
+static unsigned FreeSlot(const CellTable *t, int cell) {
+    unsigned mask = (unsigned)t->cap - 1;
+    unsigned s    = CellTableSlot(t, cell);
+    while (t->slot[s].key != -1) s = (s + 1) & mask;
+    return s;
+}
+
+/* Re-file the cells with a non-empty list into a table at most a quarter
+   full, dropping emptied ones — O(old cap), amortized over the inserts
+   that filled it */
+static void Rehash(CellTable *t) {
+    CellTableEntry *old = t->slot;
+    int oldCap = t->cap;
+
+    int live = 0;
+    for (int s = 0; s < oldCap; s++) live += old[s].key != -1 && old[s].head != -1;
+    int cap = CELL_TABLE_MIN_CAP;
+    while (cap < (live + 1) * 4) cap *= 2;
+
+    AllocSlots(t, cap);
+    for (int s = 0; s < oldCap; s++) {
+        if (old[s].key == -1 || old[s].head == -1) continue;
+        t->slot[FreeSlot(t, old[s].key)] = old[s];
+        t->used++;
+    }
+    free(old);
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+void CellTableInit(CellTable *t, int cells, int maxItems, CellTableMode mode) {
+    assert(t != NULL && cells > 0 && maxItems > 0);
+    memset(t, 0, sizeof(*t));
+    t->cells  = cells;
+    t->hashed = mode == CELL_TABLE_HASHED ||
+                (mode == CELL_TABLE_AUTO && cells / CELL_TABLE_SPARSE_RATIO > maxItems);
+
+    if (t->hashed) {
+        AllocSlots(t, CELL_TABLE_MIN_CAP);
+    } else {
+        t->head = malloc((size_t)cells * sizeof(*t->head));
+        if (!t->head) TraceLog(LOG_FATAL, "CELLS: out of memory allocating %d cells", cells);
+        memset(t->head, -1, (size_t)cells * sizeof(*t->head));
+    }
+}
+
+void CellTableFree(CellTable *t) {
+    assert(t != NULL);
+    free(t->head);
+    free(t->slot);
+    memset(t, 0, sizeof(*t));
+}
+
+void CellTableSet(CellTable *t, int cell, int head) {
+    assert(t != NULL && cell >= 0 && cell < t->cells);
+    if (!t->hashed) {
+        t->head[cell] = head;
+        return;
+    }
+
+    unsigned mask = (unsigned)t->cap - 1;
+    unsigned s    = CellTableSlot(t, cell);
+    for (; t->slot[s].key != -1; s = (s + 1) & mask) {
+        if (t->slot[s].key == cell) {
+            t->slot[s].head = head;
+            return;
+        }
+    }
+    if (head == -1) return;   /* not filed means empty already */
+
+    /* Keep linear probing at most half full */
+    if ((t->used + 1) * 2 > t->cap) {
+        Rehash(t);
+        s = FreeSlot(t, cell);
+    }
+    t->slot[s] = (CellTableEntry){ cell, head };
+    t->used++;
+}
+
+size_t CellTableBytes(const CellTable *t) {
+    assert(t != NULL);
+    return t->hashed ? (size_t)t->cap * sizeof(*t->slot)
+                     : (size_t)t->cells * sizeof(*t->head);
+}
@@ -2,6 +2,7 @@
 
 #include <math.h>
 #include "raymath.h"
+#include "rlgl.h"
 #include <assert.h>
 
 /* ── Public API ──────────────────────────────────────────────── */
@@ -15,14 +16,16 @@ void CreatureInit(Creature *c, int id, Vector2 pos, const Genome *genome) {
     c->velocity = (Vector2){ 0.0f, 0.0f };
     c->age      = 0.0f;
 
-    /* Copy genome and cache physical traits for fast physics access */
-    c->genome      = *genome;
+    /* Reference the shared genome and cache physical traits for fast physics access */
+    c->genome      = genome;
     c->size        = genome->size;
     c->speed       = genome->speed;
     c->vision      = genome->vision;
     c->visionAngle = genome->visionAngle;
     c->metabolism  = genome->metabolism;
-    /* lifespan is accessed as c->genome.lifespan — not cached separately */
+    c->rays        = (int)(genome->rays + 0.5f);
+    c->carnivory   = genome->carnivory;
+    /* lifespan is accessed as c->genome->lifespan — not cached separately */
 
     /* maxEnergy scales with cross-sectional area (size²) relative to reference size */
     float sizeRatio = c->size / CREATURE_SIZE;
@@ -33,11 +36,20 @@ void CreatureInit(Creature *c, int id, Vector2 pos, const Genome *genome) {
     c->facing = (float)GetRandomValue(0, 360) * DEG2RAD;
 
     c->reproductionCooldown = 0.0f;
+    c->attackCooldown       = 0.0f;
+    c->courting             = 0.0f;
+    c->sickSlot             = -1;
+    c->sickUntil            = 0;
+    c->immuneUntil          = 0;
     c->alive                = true;
 
+    /* No sensor cache yet — the first sense pass does a full query */
+    c->sensed          = false;
+    c->foodTargetCount = 0;
+    c->crTargetCount   = 0;
+
     /* Zero NN state */
     for (int i = 0; i < NN_INPUTS;    i++) c->nnInputs[i]  = 0.0f;
-    for (int i = 0; i < NN_HIDDEN_MAX; i++) c->hiddenOut[i] = 0.0f;
     for (int i = 0; i < NN_OUTPUTS;   i++) c->nnOutputs[i] = 0.0f;
 }
 
@@ -77,6 +89,10 @@ void CreatureUpdate(Creature *c, float dt, int worldW, int worldH) {
         c->reproductionCooldown -= dt;
         if (c->reproductionCooldown < 0.0f) c->reproductionCooldown = 0.0f;
     }
+    if (c->attackCooldown > 0.0f) {
+        c->attackCooldown -= dt;
+        if (c->attackCooldown < 0.0f) c->attackCooldown = 0.0f;
+    }
 
     /* Weight factor: energy costs scale with cross-sectional area (size²) */
     float sizeRatio = c->size / CREATURE_SIZE;
@@ -89,6 +105,7 @@ void CreatureUpdate(Creature *c, float dt, int worldW, int worldH) {
     /* Vision cost: proportional to sector area (r² × halfAngle = area/1).
        Long narrow and short wide cones of equal area cost the same. */
     drain += c->vision * c->vision * c->visionAngle * VISION_COST_SCALE;
+    if (c->sickSlot >= 0) drain *= DISEASE_DRAIN_MULT;
 
     c->energy -= drain * dt;
 
@@ -100,44 +117,73 @@ void CreatureUpdate(Creature *c, float dt, int worldW, int worldH) {
     c->age += dt;
 
     /* Die of old age — lifespan lives in genome */
-    if (c->age > c->genome.lifespan) {
+    if (c->age > c->genome->lifespan) {
         c->alive = false;
     }
 }
 
-void CreatureDraw(const Creature *c) {
-    assert(c != NULL);
-    if (!c->alive) return;
-
-    /* Compute health ratio [0..1] */
+/* Lerp dark-orange (starving) -> bright-cyan (healthy) by energy ratio */
+static Color BodyColor(const Creature *c) {
     float t = c->energy / c->maxEnergy;
     if (t < 0.0f) t = 0.0f;
     if (t > 1.0f) t = 1.0f;
 
-    /* Lerp dark-orange (starving) -> bright-cyan (healthy) */
-    Color bodyColor = {
+    return (Color){
         (unsigned char)(255 * (1.0f - t) * 0.9f),   /* r: high when starving */
         (unsigned char)(180 * t),                     /* g: grows with health  */
         (unsigned char)(220 * t),                     /* b: cyan tint when healthy */
         220
     };
+}
 
-    /* FOV cone — drawn as a proper circular sector */
-    float faceDeg  = c->facing * RAD2DEG;
-    float halfDeg  = c->visionAngle * RAD2DEG;
-    int   segments = (int)(c->visionAngle * 10.0f) + 4;
-    DrawCircleSector(c->position, c->vision,
-                     faceDeg - halfDeg, faceDeg + halfDeg,
-                     segments, (Color){ 100, 210, 255, 8 });
-    DrawCircleSectorLines(c->position, c->vision,
-                          faceDeg - halfDeg, faceDeg + halfDeg,
-                          segments, (Color){ 100, 210, 255, 30 });
+void CreatureDraw(const Creature *c, CreatureLOD lod) {
+    assert(c != NULL);
+    if (!c->alive) return;
+
+    Color bodyColor = BodyColor(c);
+
+    if (lod >= CREATURE_LOD_FULL) {
+        /* FOV cone — drawn as a proper circular sector */
+        float faceDeg  = c->facing * RAD2DEG;
+        float halfDeg  = c->visionAngle * RAD2DEG;
+        int   segments = (int)(c->visionAngle * 10.0f) + 4;
+        DrawCircleSector(c->position, c->vision,
+                         faceDeg - halfDeg, faceDeg + halfDeg,
+                         segments, (Color){ 100, 210, 255, 8 });
+        DrawCircleSectorLines(c->position, c->vision,
+                              faceDeg - halfDeg, faceDeg + halfDeg,
+                              segments, (Color){ 100, 210, 255, 30 });
+    }
 
     DrawCircleV(c->position, c->size, bodyColor);
-    DrawCircleLinesV(c->position, c->size, (Color){ 255, 255, 255, 60 });
+    if (c->sickSlot >= 0) {
+        DrawCircleLinesV(c->position, c->size + 2.0f, (Color){ 200, 90, 255, 200 });  /* sick */
+    }
+    if (c->carnivory >= PREDATION_MIN_CARNIVORY) {
+        DrawCircleLinesV(c->position, c->size, (Color){ 255, 140, 60, 200 });  /* hunter */
+    } else if (lod >= CREATURE_LOD_FULL) {
+        DrawCircleLinesV(c->position, c->size, (Color){ 255, 255, 255, 60 });
+    }
 
     /* Direction line toward current heading */
     Vector2 dir     = { cosf(c->facing), sinf(c->facing) };
     Vector2 lineEnd = Vector2Add(c->position, Vector2Scale(dir, c->size * 1.8f));
     DrawLineV(c->position, lineEnd, (Color){ 255, 255, 255, 120 });
 }
+
+void CreatureDrawPoint(const Creature *c, float minSize) {
+    assert(c != NULL);
+    if (!c->alive) return;
+
+    Color col  = BodyColor(c);
+    float half = fmaxf(c->size, minSize * 0.5f);
+    float x0 = c->position.x - half, x1 = c->position.x + half;
+    float y0 = c->position.y - half, y1 = c->position.y + half;
+
+    /* Counter-clockwise, matching raylib's own quad winding */
+    rlColor4ub(col.r, col.g, col.b, col.a);
+    rlVertex2f(x0, y0);
+    rlVertex2f(x0, y1);
+    rlVertex2f(x1, y1);
+    rlVertex2f(x1, y0);
+}
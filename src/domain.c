@@ -0,0 +1,116 @@
+#include "domain.h"
+#include "workers.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Two-color scheduling on a torus needs an even strip count, and a strip
+   must be at least two rows tall so that same-color strips are separated
+   by more than the one-row reach of the eat pass. */
+_Static_assert(DOMAIN_STRIPS % 2 == 0, "DOMAIN_STRIPS must be even");
+
+/* ── Internal helpers ────────────────────────────────────────── */
+
+/* Job context for one parallel phase */
+typedef struct {
+    const Domain    *d;
+    DomainCreatureFn fn;
+    void            *ctx;
+    int              firstStrip;  /* strip handled by job 0 */
+    int              stripStep;   /* strip distance between consecutive jobs */
+} DomainJob;
+
+static void RunStrip(void *arg, int job) {
+    const DomainJob *j = (const DomainJob *)arg;
+    int strip = j->firstStrip + job * j->stripStep;
+    for (int k = j->d->start[strip]; k < j->d->start[strip + 1]; k++) {
+        j->fn(j->ctx, strip, j->d->order[k]);
+    }
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+void DomainInit(Domain *d, int gridRows) {
+    assert(d != NULL && gridRows > 0);
+    memset(d, 0, sizeof(*d));
+    d->gridRows = gridRows;
+
+    /* As many strips as fit at two rows each, rounded down to even */
+    int strips = gridRows / 2;
+    if (strips > DOMAIN_STRIPS) strips = DOMAIN_STRIPS;
+    strips &= ~1;
+    d->stripCount = strips >= 2 ? strips : 1;
+}
+
+void DomainFree(Domain *d) {
+    assert(d != NULL);
+    free(d->order);
+    free(d->stripOf);
+    d->order   = NULL;
+    d->stripOf = NULL;
+    d->cap     = 0;
+}
+
+int DomainStripOfRow(const Domain *d, int row) {
+    return row * d->stripCount / d->gridRows;
+}
+
+void DomainAssign(Domain *d, const Creature *creatures, int creatureCount) {
+    assert(d != NULL && (creatures != NULL || creatureCount == 0));
+
+    /* Index arrays track the creature pool's capacity */
+    if (creatureCount > d->cap) {
+        int cap = d->cap > 0 ? d->cap : POOL_INITIAL_CAPACITY;
+        while (cap < creatureCount) cap *= 2;
+        int           *order   = realloc(d->order,   (size_t)cap * sizeof(*d->order));
+        unsigned char *stripOf = realloc(d->stripOf, (size_t)cap * sizeof(*d->stripOf));
+        if (order)   d->order   = order;
+        if (stripOf) d->stripOf = stripOf;
+        if (!order || !stripOf) TraceLog(LOG_FATAL, "DOMAIN: out of memory growing index to %d", cap);
+        d->cap = cap;
+    }
+
+    int counts[DOMAIN_STRIPS] = {0};
+
+    /* Pass 1: owning strip per creature, and strip sizes */
+    for (int i = 0; i < creatureCount; i++) {
+        if (!creatures[i].alive) continue;
+        int row   = (int)(creatures[i].position.y / GRID_CELL_SIZE) % d->gridRows;
+        int strip = DomainStripOfRow(d, row);
+        d->stripOf[i] = (unsigned char)strip;
+        counts[strip]++;
+    }
+
+    /* Prefix sum into start offsets */
+    d->start[0] = 0;
+    for (int k = 0; k < d->stripCount; k++) d->start[k + 1] = d->start[k] + counts[k];
+
+    /* Pass 2: scatter indices; ascending index order within each strip
+       keeps results independent of the worker count */
+    int cursor[DOMAIN_STRIPS];
+    memcpy(cursor, d->start, sizeof(cursor));
+    for (int i = 0; i < creatureCount; i++) {
+        if (!creatures[i].alive) continue;
+        d->order[cursor[d->stripOf[i]]++] = i;
+    }
+}
+
+void DomainForEach(const Domain *d, DomainCreatureFn fn, void *ctx) {
+    assert(d != NULL && fn != NULL);
+    DomainJob job = { d, fn, ctx, 0, 1 };
+    WorkersRun(RunStrip, &job, d->stripCount);
+}
+
+void DomainForEachColored(const Domain *d, DomainCreatureFn fn, void *ctx) {
+    assert(d != NULL && fn != NULL);
+    /* A single strip (tiny world) has no neighbour to race with */
+    if (d->stripCount == 1) {
+        DomainForEach(d, fn, ctx);
+        return;
+    }
+    for (int color = 0; color < 2; color++) {
+        DomainJob job = { d, fn, ctx, color, 2 };
+        WorkersRun(RunStrip, &job, d->stripCount / 2);
+    }
+}
@@ -0,0 +1,201 @@
+#include "fertility.h"
+#include "config.h"
+
+#include "raylib.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ── Internal helpers ────────────────────────────────────────── */
+
+static void MarkChanged(FertilityMap *m) {
+    m->stale = true;
+    m->version++;
+}
+
+/* Grid cells covered by map column (or row) `at` of a grid gridCells
+   wide (or tall): block, less at the far edge when the grid isn't a whole
+   number of blocks */
+static int BlockSpan(const FertilityMap *m, int at, int gridCells) {
+    int left = gridCells - at * m->block;
+    return left < m->block ? left : m->block;
+}
+
+/* Spawn mass of map cell i: its weight times the grid cells it covers */
+static double CellMass(const FertilityMap *m, int i) {
+    if (m->block == 1) return m->weight[i];
+    int area = BlockSpan(m, i % m->cols, m->gridCols) * BlockSpan(m, i / m->cols, m->gridRows);
+    return (double)m->weight[i] * area;
+}
+
+/* Vose's alias method: scale masses so they average 1, then pair each
+   under-full cell with an over-full one that tops it up. O(map cells). */
+static void BuildAliasTable(FertilityMap *m) {
+    int    n     = m->cols * m->rows;
+    double total = 0.0;
+    for (int i = 0; i < n; i++) total += CellMass(m, i);
+
+    int *small = malloc((size_t)n * sizeof(*small));
+    int *large = malloc((size_t)n * sizeof(*large));
+    if (!small || !large) TraceLog(LOG_FATAL, "FERTILITY: out of memory building alias table");
+
+    int ns = 0, nl = 0;
+    for (int i = 0; i < n; i++) {
+        m->aliasProb[i] = total > 0.0 ? (float)(CellMass(m, i) * n / total) : 1.0f;
+        m->alias[i]     = i;
+        if (m->aliasProb[i] < 1.0f) small[ns++] = i;
+        else                        large[nl++] = i;
+    }
+    while (ns > 0 && nl > 0) {
+        int s = small[--ns];
+        int l = large[nl - 1];
+        m->alias[s]      = l;
+        m->aliasProb[l] -= 1.0f - m->aliasProb[s];
+        if (m->aliasProb[l] < 1.0f) { nl--; small[ns++] = l; }
+    }
+    /* Leftovers are 1 up to rounding error */
+    while (nl > 0) m->aliasProb[large[--nl]] = 1.0f;
+    while (ns > 0) m->aliasProb[small[--ns]] = 1.0f;
+
+    free(small);
+    free(large);
+    m->stale = false;
+}
+
+/* Uniform float in [0, 1) from the raylib RNG (15 bits, like RAND_MAX on MSVC) */
+static float RandUnit(void) {
+    return (float)GetRandomValue(0, 0x7FFF) * (1.0f / 0x8000);
+}
+
+/* Value noise on a lattice of lc × lr random values that wraps at the grid
+   edges (the world is toroidal), smoothstep-interpolated at cell (x, y) */
+static float LatticeNoise(const float *lattice, int lc, int lr, int cols, int rows, int x, int y) {
+    float u  = (x + 0.5f) * lc / cols;
+    float v  = (y + 0.5f) * lr / rows;
+    int   x0 = (int)u, y0 = (int)v;
+    float fx = u - x0, fy = v - y0;
+    fx = fx * fx * (3.0f - 2.0f * fx);
+    fy = fy * fy * (3.0f - 2.0f * fy);
+    int   x1 = (x0 + 1) % lc, y1 = (y0 + 1) % lr;
+    float a  = lattice[y0 * lc + x0], b = lattice[y0 * lc + x1];
+    float c  = lattice[y1 * lc + x0], d = lattice[y1 * lc + x1];
+    return (a + (b - a) * fx) * (1.0f - fy) + (c + (d - c) * fx) * fy;
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+void FertilityInit(FertilityMap *m, int gridCols, int gridRows) {
+    assert(m != NULL && gridCols > 0 && gridRows > 0);
+    memset(m, 0, sizeof(*m));
+    m->gridCols = gridCols;
+    m->gridRows = gridRows;
+
+    /* Coarsen until the map fits the budget */
+    m->block = 1;
+    for (;;) {
+        m->cols = (gridCols + m->block - 1) / m->block;
+        m->rows = (gridRows + m->block - 1) / m->block;
+        if ((long long)m->cols * m->rows <= FERTILITY_MAX_CELLS) break;
+        m->block++;
+    }
+
+    size_t n     = (size_t)m->cols * m->rows;
+    m->weight    = malloc(n * sizeof(*m->weight));
+    m->aliasProb = malloc(n * sizeof(*m->aliasProb));
+    m->alias     = malloc(n * sizeof(*m->alias));
+    if (!m->weight || !m->aliasProb || !m->alias) TraceLog(LOG_FATAL, "FERTILITY: out of memory allocating map");
+
+    for (size_t i = 0; i < n; i++) m->weight[i] = 1.0f;
+    MarkChanged(m);
+}
+
+void FertilityFree(FertilityMap *m) {
+    assert(m != NULL);
+    free(m->weight);
+    free(m->aliasProb);
+    free(m->alias);
+    memset(m, 0, sizeof(*m));
+}
+
+void FertilityGenerate(FertilityMap *m) {
+    assert(m != NULL);
+
+    /* FERTILITY_OCTAVES octaves, the coarsest with features of about
+       FERTILITY_FEATURE_CELLS grid cells (at least a map cell), each half
+       the size and weight */
+    int    n   = m->cols * m->rows;
+    float *sum = calloc((size_t)n, sizeof(*sum));
+    if (!sum) TraceLog(LOG_FATAL, "FERTILITY: out of memory generating map");
+
+    float amp = 1.0f, ampTotal = 0.0f;
+    int   feature = FERTILITY_FEATURE_CELLS / m->block > 1 ? FERTILITY_FEATURE_CELLS / m->block : 1;
+    for (int o = 0; o < FERTILITY_OCTAVES; o++) {
+        int lc = m->cols / feature > 1 ? m->cols / feature : 2;
+        int lr = m->rows / feature > 1 ? m->rows / feature : 2;
+        float *lattice = malloc((size_t)lc * lr * sizeof(*lattice));
+        if (!lattice) TraceLog(LOG_FATAL, "FERTILITY: out of memory generating map");
+        for (int i = 0; i < lc * lr; i++) lattice[i] = RandUnit();
+
+        for (int y = 0; y < m->rows; y++) {
+            for (int x = 0; x < m->cols; x++) {
+                sum[y * m->cols + x] += amp * LatticeNoise(lattice, lc, lr, m->cols, m->rows, x, y);
+            }
+        }
+        free(lattice);
+        ampTotal += amp;
+        amp      *= 0.5f;
+        feature   = feature > 2 ? feature / 2 : 1;
+    }
+
+    /* Noise averages 0.5: cut below FERTILITY_BARREN to the floor and
+       stretch the rest, so lush patches stand out from near-desert */
+    for (int i = 0; i < n; i++) {
+        float t = (sum[i] / ampTotal - FERTILITY_BARREN) / (1.0f - FERTILITY_BARREN);
+        t = t < 0.0f ? 0.0f : t;
+        m->weight[i] = FERTILITY_FLOOR + t * t;
+    }
+    free(sum);
+    MarkChanged(m);
+}
+
+bool FertilityLoadImage(FertilityMap *m, const char *path) {
+    assert(m != NULL && path != NULL);
+    Image img = LoadImage(path);
+    if (!IsImageValid(img)) return false;
+
+    ImageResize(&img, m->cols, m->rows);
+    Color *px = LoadImageColors(img);
+    if (!px) {
+        UnloadImage(img);
+        return false;
+    }
+    for (int i = 0; i < m->cols * m->rows; i++) {
+        float brightness = (px[i].r + px[i].g + px[i].b) / (3.0f * 255.0f);
+        m->weight[i] = FERTILITY_FLOOR + brightness;
+    }
+    UnloadImageColors(px);
+    UnloadImage(img);
+    MarkChanged(m);
+    return true;
+}
+
+void FertilitySet(FertilityMap *m, int cell, float weight) {
+    assert(m != NULL && cell >= 0 && cell < m->cols * m->rows);
+    assert(weight >= 0.0f);
+    m->weight[cell] = weight;
+    MarkChanged(m);
+}
+
+int FertilitySample(FertilityMap *m) {
+    assert(m != NULL);
+    if (m->stale) BuildAliasTable(m);
+    int cell = GetRandomValue(0, m->cols * m->rows - 1);
+    cell = RandUnit() < m->aliasProb[cell] ? cell : m->alias[cell];
+    if (m->block == 1) return cell;
+
+    /* A grid cell of the block, uniformly */
+    int bx = cell % m->cols, by = cell / m->cols;
+    int gx = bx * m->block + GetRandomValue(0, BlockSpan(m, bx, m->gridCols) - 1);
+    int gy = by * m->block + GetRandomValue(0, BlockSpan(m, by, m->gridRows) - 1);
+    return gy * m->gridCols + gx;
+}
@@ -1,189 +1,394 @@
 #include "genome.h"
+#include "activation.h"
+#include "rng.h"
 
 #include <math.h>
 #include <assert.h>
+#include <float.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #include "raylib.h"
 #include "raymath.h"
 
-/* ── Internal helpers ────────────────────────────────────────── */
+/* ── Scratch buffer ──────────────────────────────────────────── */
+
+/* Every genome built or mutated here lives in one growable buffer until the
+   caller copies it into the pool; the capacity only ever grows to the
+   largest genome seen. */
+static Genome *s_scratch    = NULL;
+static size_t  s_scratchCap = 0;
+
+/* Make the scratch buffer hold at least `bytes`; may move it */
+static Genome *ScratchReserve(size_t bytes) {
+    if (bytes > s_scratchCap) {
+        size_t cap = s_scratchCap > 0 ? s_scratchCap : 256;
+        while (cap < bytes) cap *= 2;
+        Genome *g = realloc(s_scratch, cap);
+        if (!g) TraceLog(LOG_FATAL, "GENOME: out of memory growing scratch to %zu bytes", cap);
+        s_scratch    = g;
+        s_scratchCap = cap;
+    }
+    return s_scratch;
+}
+
+/* Insert a connection behind the last one with the same or a lower target,
+   moving the later connections, the markings and the activation codes up
+   one slot, so connections stay grouped by target (see Genome.conns). g must
+   be the scratch buffer with room for one more connection. */
+static void InsertConn(Genome *g, int from, int to, int16_t weight) {
+    int at = g->connCount;
+    while (at > 0 && g->conns[at - 1].to > to) at--;
+    memmove(g->conns + at + 1, g->conns + at,
+            (size_t)(g->connCount - at) * sizeof(NNConn) + GenomeTailBytes(g->hiddenCount));
+    g->conns[at] = (NNConn){ (uint8_t)from, (uint8_t)to, weight };
+    g->connCount++;
+}
+
+/* Remove connection c, moving the later connections, the markings and the
+   activation codes down one slot */
+static NNConn RemoveConn(Genome *g, int c) {
+    NNConn old = g->conns[c];
+    memmove(g->conns + c, g->conns + c + 1,
+            (size_t)(g->connCount - c - 1) * sizeof(NNConn) + GenomeTailBytes(g->hiddenCount));
+    g->connCount--;
+    return old;
+}
+
+/* ── Innovation registry ─────────────────────────────────────── */
+
+/* Node marking handed out for each connection split so far this run, keyed
+   by the split connection's innovation number. Open addressing with linear
+   probing; mark 0 (an input's marking) flags an empty slot. */
+static struct {
+    uint64_t *split;
+    uint32_t *mark;
+    int       cap;
+    int       used;
+    uint32_t  next;   /* next fresh marking; 0 until the first one */
+} s_registry;
+
+static uint32_t RegistrySlot(uint64_t key, int cap) {
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & (uint32_t)(cap - 1);
+}
+
+/* A marking no node has had yet this run */
+static uint32_t FreshMark(void) {
+    if (s_registry.next < NN_MARK_HIDDEN_BASE) s_registry.next = NN_MARK_HIDDEN_BASE;
+    if (s_registry.next == UINT32_MAX) TraceLog(LOG_FATAL, "GENOME: out of node markings");
+    return s_registry.next++;
+}
+
+static void RegistryGrow(void) {
+    int       oldCap = s_registry.cap;
+    uint64_t *split  = s_registry.split;
+    uint32_t *mark   = s_registry.mark;
 
-/* Apply an activation function to value x */
-static float ApplyActivation(ActivationFunc fn, float x) {
-    switch (fn) {
-        case ACT_LINEAR:  return x;
-        case ACT_RELU:    return x > 0.0f ? x : 0.0f;
-        case ACT_SIGMOID: return 1.0f / (1.0f + expf(-x));
-        case ACT_TANH:    return tanhf(x);
-        case ACT_SIN:     return sinf(x);
-        case ACT_COS:     return cosf(x);
-        case ACT_ABS:     return fabsf(x);
-        case ACT_STEP:    return x >= 0.0f ? 1.0f : 0.0f;
-        default:          return x;
+    s_registry.cap   = oldCap > 0 ? oldCap * 2 : 1024;
+    s_registry.split = malloc((size_t)s_registry.cap * sizeof(*s_registry.split));
+    s_registry.mark  = calloc((size_t)s_registry.cap, sizeof(*s_registry.mark));
+    if (!s_registry.split || !s_registry.mark) {
+        TraceLog(LOG_FATAL, "GENOME: out of memory growing the innovation registry to %d", s_registry.cap);
     }
+    for (int i = 0; i < oldCap; i++) {
+        if (mark[i] == 0) continue;
+        uint32_t at = RegistrySlot(split[i], s_registry.cap);
+        while (s_registry.mark[at] != 0) at = (at + 1) & (uint32_t)(s_registry.cap - 1);
+        s_registry.split[at] = split[i];
+        s_registry.mark[at]  = mark[i];
+    }
+    free(split);
+    free(mark);
+}
+
+/* Marking for the node that splits the connection with innovation number
+   `split`: the one an earlier split of it got, else a fresh one */
+static uint32_t RegistryMark(uint64_t split) {
+    if ((s_registry.used + 1) * 2 > s_registry.cap) RegistryGrow();
+    uint32_t at = RegistrySlot(split, s_registry.cap);
+    for (; s_registry.mark[at] != 0; at = (at + 1) & (uint32_t)(s_registry.cap - 1)) {
+        if (s_registry.split[at] == split) return s_registry.mark[at];
+    }
+    s_registry.split[at] = split;
+    s_registry.mark[at]  = FreshMark();
+    s_registry.used++;
+    return s_registry.mark[at];
 }
 
-/* Uniform random float in [0, 1] */
-static float RandFloat(void) {
-    return (float)GetRandomValue(0, 10000) / 10000.0f;
+static void RegistryReset(void) {
+    free(s_registry.split);
+    free(s_registry.mark);
+    memset(&s_registry, 0, sizeof(s_registry));
 }
 
 /* ── Mutation helpers (internal) ─────────────────────────────── */
 
-/* Perturb existing connection weights */
-static void MutateWeights(Genome *g, float rate) {
-    for (int c = 0; c < g->connCount; c++) {
-        if (RandFloat() < rate) {
-            g->conns[c].weight += (RandFloat() * 2.0f - 1.0f) * 0.5f;
-            if (g->conns[c].weight >  4.0f) g->conns[c].weight =  4.0f;
-            if (g->conns[c].weight < -4.0f) g->conns[c].weight = -4.0f;
+/* Copy-on-write view of the genome being mutated: reads go through cur
+   (the parent until something changes), and the first write copies the
+   parent into the scratch buffer and redirects cur there. */
+typedef struct {
+    const Genome *cur;
+} GenomeCOW;
+
+/* Writable genome with room for `moreHidden` hidden nodes and `moreConns`
+   connections beyond its current counts */
+static Genome *Writable(GenomeCOW *w, int moreHidden, int moreConns) {
+    size_t bytes = GenomeBytes(w->cur->hiddenCount + moreHidden, w->cur->connCount + moreConns);
+    if (w->cur != s_scratch) {
+        Genome *g = ScratchReserve(bytes);
+        memcpy(g, w->cur, GenomeSize(w->cur));
+        w->cur = g;
+    } else {
+        w->cur = ScratchReserve(bytes);
+    }
+    return s_scratch;
+}
+
+/* Perturb existing connection weights, a block of connections at a time:
+   one bulk draw per block, u[c] decides whether weight c mutates, u[n + c]
+   is its step. The apply loop is branch-free (select + clamp, in fixed
+   point) so it vectorizes. */
+#define WEIGHT_BLOCK  64
+static void MutateWeights(GenomeCOW *w, float rate) {
+    for (int base = 0; base < w->cur->connCount; base += WEIGHT_BLOCK) {
+        int n = w->cur->connCount - base;
+        if (n > WEIGHT_BLOCK) n = WEIGHT_BLOCK;
+
+        float u[2 * WEIGHT_BLOCK];
+        RngUniforms(u, 2 * n);
+
+        int fired = 0;
+        for (int c = 0; c < n; c++) fired += u[c] < rate;
+        if (fired == 0) continue;
+
+        NNConn *conns = Writable(w, 0, 0)->conns + base;
+        for (int c = 0; c < n; c++) {
+            int old = conns[c].weight;
+            int v   = old + (int)((u[n + c] * 2.0f - 1.0f) * 0.5f * NN_WEIGHT_SCALE);
+            v = v >  32767 ?  32767 : v;
+            v = v < -32768 ? -32768 : v;
+            conns[c].weight = (int16_t)(u[c] < rate ? v : old);
         }
     }
 }
 
 /* Add a new connection between a valid source and target node */
-static void MutateAddConnection(Genome *g) {
-    if (g->connCount >= NN_CONN_MAX) return;
+static void MutateAddConnection(GenomeCOW *w) {
+    const Genome *src = w->cur;
+    if (src->connCount >= NN_CONN_LIMIT) return;
 
     /* from: any input (0..NN_INPUTS-1) or any active hidden node */
-    int fromRange = NN_INPUTS + g->hiddenCount;
+    int fromRange = NN_INPUTS + src->hiddenCount;
     int fromSlot  = GetRandomValue(0, fromRange - 1);
     int fromNode  = (fromSlot < NN_INPUTS) ? fromSlot
                                            : NN_NODE_HIDDEN_BASE + (fromSlot - NN_INPUTS);
 
     /* to: any active hidden node with index > fromNode (avoids backward cycles),
-       or any output node */
-    int targets[NN_HIDDEN_MAX + NN_OUTPUTS];
-    int targetCount = 0;
-
-    for (int h = 0; h < g->hiddenCount; h++) {
-        int hidNode = NN_NODE_HIDDEN_BASE + h;
-        if (hidNode > fromNode) targets[targetCount++] = hidNode;
-    }
-    for (int o = 0; o < NN_OUTPUTS; o++) targets[targetCount++] = NN_NODE_OUT_BASE + o;
-
-    if (targetCount == 0) return;
+       or any output node — drawn from that range without building a list */
+    int firstHidden = fromNode + 1 > NN_NODE_HIDDEN_BASE ? fromNode + 1 : NN_NODE_HIDDEN_BASE;
+    int hiddenTargets = NN_NODE_HIDDEN_BASE + src->hiddenCount - firstHidden;
+    if (hiddenTargets < 0) hiddenTargets = 0;
 
-    int toNode = targets[GetRandomValue(0, targetCount - 1)];
+    int pick   = GetRandomValue(0, hiddenTargets + NN_OUTPUTS - 1);
+    int toNode = pick < hiddenTargets ? firstHidden + pick
+                                      : NN_NODE_OUT_BASE + (pick - hiddenTargets);
 
-    g->conns[g->connCount].from   = fromNode;
-    g->conns[g->connCount].to     = toNode;
-    g->conns[g->connCount].weight = RandFloat() * 4.0f - 2.0f;
-    g->connCount++;
+    Genome *g = Writable(w, 0, 1);
+    InsertConn(g, fromNode, toNode, NNWeightPack(RngFloat() * 4.0f - 2.0f));
 }
 
 /* Split an existing connection by inserting a new hidden node between the endpoints */
-static void MutateAddHiddenNode(Genome *g) {
-    if (g->hiddenCount >= NN_HIDDEN_MAX) return;
-    if (g->connCount == 0) return;
+static void MutateAddHiddenNode(GenomeCOW *w) {
+    if (w->cur->hiddenCount >= NN_HIDDEN_LIMIT) return;
+    if (w->cur->connCount == 0) return;
+
+    Genome *g = Writable(w, 1, 1);
 
-    /* Pick a random connection to split */
-    int    splitIdx = GetRandomValue(0, g->connCount - 1);
-    NNConn old      = g->conns[splitIdx];
+    /* Pick a random connection to split. The new node shares its marking
+       with every node split from the same connection this run, unless g
+       already has that node (it split a re-added copy of the connection). */
+    int      split = GetRandomValue(0, g->connCount - 1);
+    uint32_t mark  = RegistryMark(NNConnInnovation(g, &g->conns[split]));
+    for (int h = 0; h < g->hiddenCount; h++) {
+        if (GenomeMarks(g)[h] == mark) {
+            mark = FreshMark();
+            break;
+        }
+    }
+    NNConn old = RemoveConn(g, split);
 
     int newNode = NN_NODE_HIDDEN_BASE + g->hiddenCount;
 
     /* Redirect split connection: old.from → newNode (weight 1) */
-    g->conns[splitIdx].to     = newNode;
-    g->conns[splitIdx].weight = 1.0f;
+    InsertConn(g, old.from, newNode, NNWeightPack(1.0f));
 
     /* Add second half: newNode → old.to (inherits old weight) */
-    if (g->connCount < NN_CONN_MAX) {
-        g->conns[g->connCount].from   = newNode;
-        g->conns[g->connCount].to     = old.to;
-        g->conns[g->connCount].weight = old.weight;
-        g->connCount++;
-    }
-
-    /* Random activation for the new hidden node */
-    g->hiddenAct[g->hiddenCount] = (ActivationFunc)GetRandomValue(0, ACT_COUNT - 1);
+    if (g->connCount < NN_CONN_LIMIT) InsertConn(g, newNode, old.to, old.weight);
+
+    /* Append the marking, moving the activation codes up past it, and give
+       the node a random activation; the code bytes grow by at most one,
+       which Writable reserved */
+    uint8_t *acts = (uint8_t *)GenomeActs(g);
+    memmove(acts + sizeof(uint32_t), acts, GenomeActBytes(g->hiddenCount));
+    ((uint32_t *)GenomeMarks(g))[g->hiddenCount] = mark;
     g->hiddenCount++;
+    acts = (uint8_t *)GenomeActs(g);
+    acts[GenomeActBytes(g->hiddenCount) - 1] = 0;
+    GenomeSetHiddenAct(g, g->hiddenCount - 1, (ActivationFunc)GetRandomValue(0, ACT_COUNT - 1));
 }
 
 /* Randomize the activation function of a random existing hidden node */
-static void MutateActivation(Genome *g) {
-    if (g->hiddenCount == 0) return;
-    int h = GetRandomValue(0, g->hiddenCount - 1);
-    g->hiddenAct[h] = (ActivationFunc)GetRandomValue(0, ACT_COUNT - 1);
-}
-
-/* Perturb physical trait values within their valid ranges */
-static void MutateTraits(Genome *g, float rate) {
-    /* Capped traits — mutate within [min, max] */
-    float *traits[] = { &g->size, &g->speed, &g->visionAngle, &g->metabolism, &g->lifespan };
-    float  mins[]   = { 3.0f, 20.0f, 0.01f, 1.0f, 60.0f };
-    float  maxs[]   = { 12.0f, 120.0f, PI,  8.0f, 600.0f };
-    for (int i = 0; i < 5; i++) {
-        if (RandFloat() < rate) {
-            float range = maxs[i] - mins[i];
-            *traits[i] += (RandFloat() * 2.0f - 1.0f) * range * 0.1f;
-            if (*traits[i] < mins[i]) *traits[i] = mins[i];
-            if (*traits[i] > maxs[i]) *traits[i] = maxs[i];
+static void MutateActivation(GenomeCOW *w) {
+    if (w->cur->hiddenCount == 0) return;
+    int h = GetRandomValue(0, w->cur->hiddenCount - 1);
+    ActivationFunc act = (ActivationFunc)GetRandomValue(0, ACT_COUNT - 1);
+    if (act != GenomeHiddenAct(w->cur, h)) GenomeSetHiddenAct(Writable(w, 0, 0), h, act);
+}
+
+/* Physical trait t in Genome field order */
+static float *TraitField(Genome *g, int t) {
+    float *fields[GENOME_TRAIT_FLOATS] = { &g->size, &g->speed, &g->vision, &g->visionAngle,
+                                           &g->metabolism, &g->lifespan, &g->mutationRate, &g->rays,
+                                           &g->carnivory };
+    return fields[t];
+}
+
+/* Physical traits in Genome field order, with their clamp ranges and the
+   half-width of a mutation step (10% of range for capped traits) */
+#define TRAIT_BLOCK  9
+static const float s_traitMin[TRAIT_BLOCK]  = { 3.0f,  20.0f,  10.0f,   0.01f,               1.0f, 60.0f,  0.005f, 1.0f,                   0.0f };
+static const float s_traitMax[TRAIT_BLOCK]  = { 12.0f, 120.0f, FLT_MAX, PI,                  8.0f, 600.0f, 0.5f,   (float)SENSE_RAYS_MAX, 1.0f };
+static const float s_traitStep[TRAIT_BLOCK] = { 0.9f,  10.0f,  20.0f,   (PI - 0.01f) * 0.1f, 0.7f, 54.0f,  0.05f,  (SENSE_RAYS_MAX - 1) * 0.1f, 0.1f };
+
+/* Perturb physical trait values within their valid ranges. Vision is
+   uncapped (naturally selected, minimum 10px). Same bulk-draw, masked,
+   branch-free scheme as MutateWeights over the whole trait block. */
+static void MutateTraits(GenomeCOW *w, float rate) {
+    float u[2 * TRAIT_BLOCK];
+    RngUniforms(u, 2 * TRAIT_BLOCK);
+
+    int fired = 0;
+    for (int i = 0; i < TRAIT_BLOCK; i++) fired += u[i] < rate;
+    if (fired == 0) return;
+
+    Genome *g = Writable(w, 0, 0);
+    float  *fields[TRAIT_BLOCK] = { &g->size, &g->speed, &g->vision, &g->visionAngle,
+                                    &g->metabolism, &g->lifespan, &g->mutationRate, &g->rays,
+                                    &g->carnivory };
+    float   vals[TRAIT_BLOCK];
+    for (int i = 0; i < TRAIT_BLOCK; i++) vals[i] = *fields[i];
+
+    for (int i = 0; i < TRAIT_BLOCK; i++) {
+        float v = vals[i] + (u[TRAIT_BLOCK + i] * 2.0f - 1.0f) * s_traitStep[i];
+        v = v < s_traitMin[i] ? s_traitMin[i] : v;
+        v = v > s_traitMax[i] ? s_traitMax[i] : v;
+        vals[i] = u[i] < rate ? v : vals[i];
+    }
+
+    for (int i = 0; i < TRAIT_BLOCK; i++) *fields[i] = vals[i];
+}
+
+/* Let the child take b's gene, with probability ½ each, wherever b has the
+   same gene: weights of connections with a matching innovation number,
+   physical traits, activations of hidden nodes with a matching marking.
+   Genes only a carries are kept, so the topology stays a's. Only genes
+   whose value actually differs are written, keeping the copy-on-write
+   share when b is identical. */
+static void CrossWith(GenomeCOW *w, const Genome *b) {
+    static GeneIndex index;
+
+    GeneIndexClear(&index);
+    for (int c = 0; c < b->connCount; c++) GeneIndexPut(&index, NNConnInnovation(b, &b->conns[c]), c);
+
+    for (int base = 0; base < w->cur->connCount; base += WEIGHT_BLOCK) {
+        int n = w->cur->connCount - base;
+        if (n > WEIGHT_BLOCK) n = WEIGHT_BLOCK;
+
+        float u[WEIGHT_BLOCK];
+        RngUniforms(u, n);
+        for (int c = 0; c < n; c++) {
+            if (u[c] >= 0.5f) continue;
+            int bc = GeneIndexGet(&index, NNConnInnovation(w->cur, &w->cur->conns[base + c]));
+            if (bc < 0 || b->conns[bc].weight == w->cur->conns[base + c].weight) continue;
+            Writable(w, 0, 0)->conns[base + c].weight = b->conns[bc].weight;
         }
     }
 
-    /* Vision range — uncapped, naturally selected; minimum 10px */
-    if (RandFloat() < rate) {
-        g->vision += (RandFloat() * 2.0f - 1.0f) * 20.0f;
-        if (g->vision < 10.0f) g->vision = 10.0f;
+    float u[GENOME_TRAIT_FLOATS];
+    RngUniforms(u, GENOME_TRAIT_FLOATS);
+    for (int t = 0; t < GENOME_TRAIT_FLOATS; t++) {
+        float v = *TraitField((Genome *)b, t);
+        if (u[t] < 0.5f && v != *TraitField((Genome *)w->cur, t)) *TraitField(Writable(w, 0, 0), t) = v;
     }
-    if (RandFloat() < rate) {
-        g->mutationRate += (RandFloat() * 2.0f - 1.0f) * 0.05f;
-        if (g->mutationRate < 0.005f) g->mutationRate = 0.005f;
-        if (g->mutationRate > 0.5f)   g->mutationRate = 0.5f;
+
+    if (w->cur->hiddenCount == 0 || b->hiddenCount == 0) return;
+    GeneIndexClear(&index);
+    for (int h = 0; h < b->hiddenCount; h++) GeneIndexPut(&index, GenomeMarks(b)[h], h);
+    for (int h = 0; h < w->cur->hiddenCount; h++) {
+        int bh = GeneIndexGet(&index, GenomeMarks(w->cur)[h]);
+        if (bh < 0) continue;
+        ActivationFunc act = GenomeHiddenAct(b, bh);
+        if (RngFloat() < 0.5f && act != GenomeHiddenAct(w->cur, h)) {
+            GenomeSetHiddenAct(Writable(w, 0, 0), h, act);
+        }
     }
 }
 
 /* ── Public API ──────────────────────────────────────────────── */
 
-void GenomeRandom(Genome *g) {
-    assert(g != NULL);
+const Genome *GenomeRandom(void) {
+    Genome *g = ScratchReserve(GenomeBytes(0, NN_INPUTS * NN_OUTPUTS));
 
     /* Randomize physical traits within their natural ranges */
-    g->size         = Lerp(3.0f,   12.0f,  RandFloat());
-    g->speed        = Lerp(20.0f,  120.0f, RandFloat());
-    g->vision       = Lerp(40.0f,  200.0f, RandFloat());
-    g->visionAngle  = Lerp(0.01f,  PI,     RandFloat());
-    g->metabolism   = Lerp(1.0f,   8.0f,   RandFloat());
-    g->lifespan     = Lerp(60.0f,  600.0f, RandFloat());
-    g->mutationRate = Lerp(0.01f,  0.3f,   RandFloat());
+    g->size         = Lerp(3.0f,   12.0f,  RngFloat());
+    g->speed        = Lerp(20.0f,  120.0f, RngFloat());
+    g->vision       = Lerp(40.0f,  200.0f, RngFloat());
+    g->visionAngle  = Lerp(0.01f,  PI,     RngFloat());
+    g->metabolism   = Lerp(1.0f,   8.0f,   RngFloat());
+    g->lifespan     = Lerp(60.0f,  600.0f, RngFloat());
+    g->mutationRate = Lerp(0.01f,  0.3f,   RngFloat());
+    g->rays         = Lerp(1.0f,   (float)SENSE_RAYS_MAX, RngFloat());
+    g->carnivory    = Lerp(0.0f,   1.0f,   RngFloat());
 
     /* Start with no hidden nodes */
     g->hiddenCount = 0;
-    for (int h = 0; h < NN_HIDDEN_MAX; h++) g->hiddenAct[h] = ACT_LINEAR;
+    g->connCount   = 0;
+    memset((uint8_t *)GenomeActs(g), 0, GenomeActBytes(0));   /* ACT_LINEAR */
 
     /* Sparse input → output connections (40% probability each pair) */
-    g->connCount = 0;
     for (int i = 0; i < NN_INPUTS; i++) {
         for (int o = 0; o < NN_OUTPUTS; o++) {
-            if (RandFloat() < 0.4f && g->connCount < NN_CONN_MAX) {
-                g->conns[g->connCount].from   = i;
-                g->conns[g->connCount].to     = NN_NODE_OUT_BASE + o;
-                g->conns[g->connCount].weight = RandFloat() * 4.0f - 2.0f;
-                g->connCount++;
+            if (RngFloat() < 0.4f) {
+                InsertConn(g, i, NN_NODE_OUT_BASE + o, NNWeightPack(RngFloat() * 4.0f - 2.0f));
             }
         }
     }
+    return g;
 }
 
-void GenomeCrossover(const Genome *a, const Genome *b, Genome *child, float mutationRate) {
-    assert(a != NULL && b != NULL && child != NULL);
+const Genome *GenomeCrossover(const Genome *a, const Genome *b, float mutationRate) {
+    assert(a != NULL && b != NULL);
+    assert(a != s_scratch && b != s_scratch);   /* store the parents before crossing them */
 
-    /* Start as an exact copy of parent a (asexual reproduction — b ignored for now) */
-    *child = *a;
-    (void)b;
+    /* Start as a shared view of parent a; the scratch copy is only made once
+       crossover or a mutation actually changes something */
+    GenomeCOW w = { a };
+    if (b != a) CrossWith(&w, b);
 
     float structRate = mutationRate * 0.25f;
 
-    MutateWeights(child, mutationRate);
-    MutateTraits(child, mutationRate);
-    if (RandFloat() < structRate)          MutateAddConnection(child);
-    if (RandFloat() < structRate * 0.4f)   MutateAddHiddenNode(child);
-    if (RandFloat() < structRate)          MutateActivation(child);
+    MutateWeights(&w, mutationRate);
+    MutateTraits(&w, mutationRate);
+    if (RngFloat() < structRate)          MutateAddConnection(&w);
+    if (RngFloat() < structRate * 0.4f)   MutateAddHiddenNode(&w);
+    if (RngFloat() < structRate)          MutateActivation(&w);
+
+    return w.cur;
 }
 
 void GenomeEvalNN(const Genome *g, const float inputs[NN_INPUTS],
-                  float hidden_out[NN_HIDDEN_MAX], float outputs[NN_OUTPUTS]) {
-    assert(g != NULL && inputs != NULL && hidden_out != NULL && outputs != NULL);
+                  float *hidden_out, float outputs[NN_OUTPUTS]) {
+    assert(g != NULL && inputs != NULL && outputs != NULL);
 
     /* Node value array indexed by global node index */
     float nodeVals[NN_NODE_COUNT] = {0};
@@ -191,30 +396,35 @@ void GenomeEvalNN(const Genome *g, const float inputs[NN_INPUTS],
     /* Load inputs into node value slots */
     for (int i = 0; i < NN_INPUTS; i++) nodeVals[i] = inputs[i];
 
+    /* Connections are grouped by target in node order, so one pass over
+       them sums each node's inputs just before the node is evaluated */
+    const NNConn *c   = g->conns;
+    const NNConn *end = g->conns + g->connCount;
+
     /* Process hidden nodes in slot order (topologically sorted by construction) */
     for (int h = 0; h < g->hiddenCount; h++) {
         int   nodeIdx = NN_NODE_HIDDEN_BASE + h;
         float sum     = 0.0f;
-        for (int c = 0; c < g->connCount; c++) {
-            if (g->conns[c].to == nodeIdx)
-                sum += nodeVals[g->conns[c].from] * g->conns[c].weight;
-        }
-        nodeVals[nodeIdx] = ApplyActivation(g->hiddenAct[h], sum);
-        hidden_out[h]     = nodeVals[nodeIdx];
+        for (; c < end && c->to == nodeIdx; c++) sum += nodeVals[c->from] * NNConnWeight(c);
+        nodeVals[nodeIdx] = ActivationApply(GenomeHiddenAct(g, h), sum);
+        if (hidden_out) hidden_out[h] = nodeVals[nodeIdx];
     }
 
     /* Process output nodes */
     for (int o = 0; o < NN_OUTPUTS; o++) {
         int   nodeIdx = NN_NODE_OUT_BASE + o;
         float sum     = 0.0f;
-        for (int c = 0; c < g->connCount; c++) {
-            if (g->conns[c].to == nodeIdx)
-                sum += nodeVals[g->conns[c].from] * g->conns[c].weight;
-        }
+        for (; c < end && c->to == nodeIdx; c++) sum += nodeVals[c->from] * NNConnWeight(c);
         /* tanh for thrust/turn (outputs 0,1), sigmoid for reproduce (output 2) */
-        if (o < 2) outputs[o] = tanhf(sum);
-        else       outputs[o] = 1.0f / (1.0f + expf(-sum));
+        if (o < 2) outputs[o] = ActivationTanh(sum);
+        else       outputs[o] = ActivationSigmoid(sum);
     }
+    assert(c == end);
+}
+
+void GenomeReseed(void) {
+    RngReseed();
+    RegistryReset();
 }
 
 const char *ActivationFuncName(ActivationFunc f) {
@@ -231,3 +441,177 @@ const char *ActivationFuncName(ActivationFunc f) {
     if (f < 0 || f >= ACT_COUNT) return "unknown";
     return names[f];
 }
+
+/* ── Serialization ───────────────────────────────────────────── */
+
+/* Serialized byte count for a topology of the given size, without the
+   node markings (as written before they existed) */
+static int EncodedBytesUnmarked(int hiddenCount, int connCount) {
+    return GENOME_TRAIT_FLOATS * 4 + 4 + (int)GenomeActBytes(hiddenCount) + connCount * 4;
+}
+
+/* Serialized byte count for a topology of the given size */
+static int EncodedBytes(int hiddenCount, int connCount) {
+    return EncodedBytesUnmarked(hiddenCount, connCount) + hiddenCount * 4;
+}
+
+int GenomeHexSize(const Genome *g) {
+    assert(g != NULL);
+    return EncodedBytes(g->hiddenCount, g->connCount) * 2 + 1;
+}
+
+/* Emit one byte as two hex digits */
+static char *PutHex(char *out, unsigned byte) {
+    static const char hex[] = "0123456789ABCDEF";
+    out[0] = hex[(byte >> 4) & 15];
+    out[1] = hex[byte & 15];
+    return out + 2;
+}
+
+void GenomeEncode(const Genome *g, char *buf, int bufSize) {
+    assert(g != NULL && buf != NULL);
+    if (bufSize < GenomeHexSize(g)) {
+        if (bufSize > 0) buf[0] = '\0';
+        return;
+    }
+
+    char *out = buf;
+    for (int t = 0; t < GENOME_TRAIT_FLOATS; t++) {
+        uint32_t bits;
+        memcpy(&bits, TraitField((Genome *)g, t), sizeof(bits));
+        for (int k = 0; k < 4; k++) out = PutHex(out, bits >> (8 * k));
+    }
+    out = PutHex(out, g->hiddenCount);
+    out = PutHex(out, g->hiddenCount >> 8);
+    out = PutHex(out, g->connCount);
+    out = PutHex(out, g->connCount >> 8);
+    const uint8_t *acts = GenomeActs(g);
+    for (size_t k = 0; k < GenomeActBytes(g->hiddenCount); k++) out = PutHex(out, acts[k]);
+    for (int c = 0; c < g->connCount; c++) {
+        uint16_t w = (uint16_t)g->conns[c].weight;
+        out = PutHex(out, g->conns[c].from);
+        out = PutHex(out, g->conns[c].to);
+        out = PutHex(out, w);
+        out = PutHex(out, w >> 8);
+    }
+    for (int h = 0; h < g->hiddenCount; h++) {
+        uint32_t mark = GenomeMarks(g)[h];
+        for (int k = 0; k < 4; k++) out = PutHex(out, mark >> (8 * k));
+    }
+    *out = '\0';
+}
+
+static int HexNibble(char ch) {
+    if (ch >= '0' && ch <= '9') return ch - '0';
+    if (ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
+    if (ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
+    return -1;
+}
+
+/* Read byte i of a hex string already checked to hold at least i + 1 bytes */
+static unsigned HexByte(const char *hex, int i) {
+    return (unsigned)(HexNibble(hex[2 * i]) << 4 | HexNibble(hex[2 * i + 1]));
+}
+
+const Genome *GenomeDecode(const char *hex) {
+    assert(hex != NULL);
+    size_t len = strlen(hex);
+    if (len % 2 != 0) return NULL;
+    for (size_t k = 0; k < len; k++) {
+        if (HexNibble(hex[k]) < 0) return NULL;
+    }
+
+    int n = (int)(len / 2);
+    int p = GENOME_TRAIT_FLOATS * 4;
+    if (n < EncodedBytes(0, 0)) return NULL;
+    int  hiddenCount = (int)(HexByte(hex, p)     | HexByte(hex, p + 1) << 8);
+    int  connCount   = (int)(HexByte(hex, p + 2) | HexByte(hex, p + 3) << 8);
+    if (hiddenCount > NN_HIDDEN_LIMIT) return NULL;
+    bool marked = n == EncodedBytes(hiddenCount, connCount);
+    if (!marked && n != EncodedBytesUnmarked(hiddenCount, connCount)) return NULL;
+
+    Genome *g = ScratchReserve(GenomeBytes(hiddenCount, connCount));
+    for (int t = 0; t < GENOME_TRAIT_FLOATS; t++) {
+        uint32_t bits = 0;
+        for (int k = 0; k < 4; k++) bits |= (uint32_t)HexByte(hex, t * 4 + k) << (8 * k);
+        memcpy(TraitField(g, t), &bits, sizeof(bits));
+    }
+    g->hiddenCount = (uint16_t)hiddenCount;
+    g->connCount   = (uint16_t)connCount;
+    p += 4;
+    uint8_t *acts = (uint8_t *)GenomeActs(g);
+    for (size_t k = 0; k < GenomeActBytes(hiddenCount); k++, p++) acts[k] = (uint8_t)HexByte(hex, p);
+
+    /* Node ids must name an input or active hidden node (from) and an active
+       hidden node or an output (to) */
+    for (int c = 0; c < connCount; c++, p += 4) {
+        int from = (int)HexByte(hex, p), to = (int)HexByte(hex, p + 1);
+        bool fromOk = from < NN_INPUTS ||
+                      (from >= NN_NODE_HIDDEN_BASE && from < NN_NODE_HIDDEN_BASE + hiddenCount);
+        bool toOk   = (to >= NN_NODE_HIDDEN_BASE && to < NN_NODE_HIDDEN_BASE + hiddenCount) ||
+                      (to >= NN_NODE_OUT_BASE && to < NN_NODE_OUT_BASE + NN_OUTPUTS);
+        if (!fromOk || !toOk) return NULL;
+        g->conns[c].from   = (uint8_t)from;
+        g->conns[c].to     = (uint8_t)to;
+        g->conns[c].weight = (int16_t)(uint16_t)(HexByte(hex, p + 2) | HexByte(hex, p + 3) << 8);
+    }
+
+    /* Markings must be hidden ones and distinct within the genome; later
+       fresh markings start past them. Unmarked strings get fresh ones. */
+    uint32_t *marks = (uint32_t *)GenomeMarks(g);
+    for (int h = 0; h < hiddenCount; h++, p += 4) {
+        uint32_t mark = 0;
+        if (marked) {
+            for (int k = 0; k < 4; k++) mark |= (uint32_t)HexByte(hex, p + k) << (8 * k);
+            if (mark < NN_MARK_HIDDEN_BASE || mark == UINT32_MAX) return NULL;
+            for (int e = 0; e < h; e++) {
+                if (marks[e] == mark) return NULL;
+            }
+            if (mark >= s_registry.next) s_registry.next = mark + 1;
+        } else {
+            mark = FreshMark();
+        }
+        marks[h] = mark;
+    }
+
+    /* Group by target (stable, so each node still sums in stored order);
+       checkpoints written before the grouping are in creation order */
+    for (int c = 1; c < connCount; c++) {
+        NNConn x = g->conns[c];
+        int    k = c;
+        for (; k > 0 && g->conns[k - 1].to > x.to; k--) g->conns[k] = g->conns[k - 1];
+        g->conns[k] = x;
+    }
+    return g;
+}
+
+/* ── Gene index ──────────────────────────────────────────────── */
+
+static uint32_t GeneSlot(uint64_t key) {
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & (GENE_INDEX_SLOTS - 1);
+}
+
+void GeneIndexClear(GeneIndex *x) {
+    assert(x != NULL);
+    if (++x->stamp == 0) {
+        memset(x->stampOf, 0, sizeof(x->stampOf));
+        x->stamp = 1;
+    }
+}
+
+void GeneIndexPut(GeneIndex *x, uint64_t key, int value) {
+    assert(x != NULL && x->stamp != 0);
+    uint32_t at = GeneSlot(key);
+    while (x->stampOf[at] == x->stamp && x->key[at] != key) at = (at + 1) & (GENE_INDEX_SLOTS - 1);
+    x->stampOf[at] = x->stamp;
+    x->key[at]     = key;
+    x->value[at]   = value;
+}
+
+int GeneIndexGet(const GeneIndex *x, uint64_t key) {
+    assert(x != NULL && x->stamp != 0);
+    for (uint32_t at = GeneSlot(key); x->stampOf[at] == x->stamp; at = (at + 1) & (GENE_INDEX_SLOTS - 1)) {
+        if (x->key[at] == key) return x->value[at];
+    }
+    return -1;
+}
@@ -0,0 +1,128 @@
+#include "genome_pool.h"
+#include "raylib.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ── Internal helpers ────────────────────────────────────────── */
+
+static size_t SlotBytes(int cls) {
+    return (size_t)GENOME_POOL_MIN_SLOT << cls;
+}
+
+static int SlotsPerSlab(int cls) {
+    size_t n = GENOME_POOL_SLAB_BYTES / SlotBytes(cls);
+    return n > 0 ? (int)n : 1;
+}
+
+/* Smallest size class whose slots hold `bytes` */
+static int SizeClassFor(size_t bytes) {
+    int cls = 0;
+    while (cls < GENOME_POOL_CLASSES && SlotBytes(cls) < bytes) cls++;
+    if (cls == GENOME_POOL_CLASSES) TraceLog(LOG_FATAL, "GENOME: %zu-byte genome exceeds the largest pool slot", bytes);
+    return cls;
+}
+
+/* Take a slot from a size class: the free list first, else carve the
+   newest slab, else add a slab */
+static void *SlotAlloc(GenomeSizeClass *sc, int cls) {
+    if (sc->freeList) {
+        void *slot   = sc->freeList;
+        sc->freeList = *(void **)slot;
+        return slot;
+    }
+    if (sc->slabCount == 0 || sc->slotsUsed == SlotsPerSlab(cls)) {
+        unsigned char **slabs = realloc(sc->slabs, (size_t)(sc->slabCount + 1) * sizeof(*sc->slabs));
+        unsigned char  *slab  = slabs ? malloc((size_t)SlotsPerSlab(cls) * SlotBytes(cls)) : NULL;
+        if (slabs) sc->slabs = slabs;
+        if (!slab) TraceLog(LOG_FATAL, "GENOME: out of memory adding a %zu-byte slab", SlotBytes(cls));
+        sc->slabs[sc->slabCount++] = slab;
+        sc->slotsUsed = 0;
+    }
+    return sc->slabs[sc->slabCount - 1] + (size_t)sc->slotsUsed++ * SlotBytes(cls);
+}
+
+static void SlotFree(GenomeSizeClass *sc, void *slot) {
+    *(void **)slot = sc->freeList;
+    sc->freeList   = slot;
+}
+
+/* Double the per-handle arrays */
+static void GrowHandles(GenomePool *p) {
+    int cap = p->cap > 0 ? p->cap * 2 : 256;
+    Genome       **genomes   = realloc(p->genomes,   (size_t)cap * sizeof(*p->genomes));
+    unsigned char *sizeClass = realloc(p->sizeClass, (size_t)cap * sizeof(*p->sizeClass));
+    int           *refs      = realloc(p->refs,      (size_t)cap * sizeof(*p->refs));
+    int           *freeSlots = realloc(p->freeSlots, (size_t)cap * sizeof(*p->freeSlots));
+    if (genomes)   p->genomes   = genomes;
+    if (sizeClass) p->sizeClass = sizeClass;
+    if (refs)      p->refs      = refs;
+    if (freeSlots) p->freeSlots = freeSlots;
+    if (!genomes || !sizeClass || !refs || !freeSlots)
+        TraceLog(LOG_FATAL, "GENOME: out of memory growing pool to %d", cap);
+    p->cap = cap;
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+void GenomePoolInit(GenomePool *p) {
+    assert(p != NULL);
+    memset(p, 0, sizeof(*p));
+}
+
+void GenomePoolFree(GenomePool *p) {
+    assert(p != NULL);
+    for (int c = 0; c < GENOME_POOL_CLASSES; c++) {
+        for (int i = 0; i < p->classes[c].slabCount; i++) free(p->classes[c].slabs[i]);
+        free(p->classes[c].slabs);
+    }
+    free(p->genomes);
+    free(p->sizeClass);
+    free(p->refs);
+    free(p->freeSlots);
+    memset(p, 0, sizeof(*p));
+}
+
+int GenomePoolAdd(GenomePool *p, const Genome *g) {
+    assert(p != NULL && g != NULL);
+
+    int handle;
+    if (p->freeCount > 0) {
+        handle = p->freeSlots[--p->freeCount];
+    } else {
+        if (p->count == p->cap) GrowHandles(p);
+        handle = p->count++;
+    }
+    size_t bytes = GenomeSize(g);
+    int    cls   = SizeClassFor(bytes);
+    Genome *slot = SlotAlloc(&p->classes[cls], cls);
+    memcpy(slot, g, bytes);
+    p->genomes[handle]   = slot;
+    p->sizeClass[handle] = (unsigned char)cls;
+    p->refs[handle]      = 1;
+    p->live++;
+    p->liveBytes += SlotBytes(cls);
+    return handle;
+}
+
+void GenomePoolRetain(GenomePool *p, int handle) {
+    assert(p != NULL && handle >= 0 && handle < p->count && p->refs[handle] > 0);
+    p->refs[handle]++;
+}
+
+void GenomePoolRelease(GenomePool *p, int handle) {
+    assert(p != NULL && handle >= 0 && handle < p->count && p->refs[handle] > 0);
+    if (--p->refs[handle] == 0) {
+        int cls = p->sizeClass[handle];
+        SlotFree(&p->classes[cls], p->genomes[handle]);
+        p->freeSlots[p->freeCount++] = handle;
+        p->live--;
+        p->liveBytes -= SlotBytes(cls);
+    }
+}
+
+const Genome *GenomePoolGet(const GenomePool *p, int handle) {
+    assert(p != NULL && handle >= 0 && handle < p->count);
+    return p->genomes[handle];
+}
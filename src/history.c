@@ -1,18 +1,74 @@
 #include "history.h"
 
 #include <assert.h>
+#include <string.h>
 
-/* Append one sample to the ring buffer */
-void HistoryRecord(History *h, int population, int food, float avgSpeed, float avgMetabolism) {
+/* ── Internal helpers ────────────────────────────────────────── */
+
+/* Append one bucket per series to tier t; when tier t has merged
+   HISTORY_DECIMATION buckets, push the aggregate into tier t+1. */
+static void TierPush(History *h, int t, const HistoryBucket b[HIST_SERIES_COUNT]) {
+    HistoryTier *tier = &h->tiers[t];
+
+    for (int s = 0; s < HIST_SERIES_COUNT; s++) tier->data[s][tier->head] = b[s];
+    tier->head = (tier->head + 1) % HISTORY_TIER_LEN;
+    if (tier->count < HISTORY_TIER_LEN) {
+        tier->count++;
+    }
+
+    if (t + 1 >= HISTORY_TIERS) return;
+
+    /* Merge into the pending bucket for the next tier (mean accumulates a sum) */
+    for (int s = 0; s < HIST_SERIES_COUNT; s++) {
+        HistoryBucket *p = &tier->pending[s];
+        if (tier->pendingCount == 0) {
+            *p = b[s];
+        } else {
+            if (b[s].min < p->min) p->min = b[s].min;
+            if (b[s].max > p->max) p->max = b[s].max;
+            p->mean += b[s].mean;
+        }
+    }
+
+    if (++tier->pendingCount == HISTORY_DECIMATION) {
+        for (int s = 0; s < HIST_SERIES_COUNT; s++) tier->pending[s].mean /= HISTORY_DECIMATION;
+        tier->pendingCount = 0;
+        TierPush(h, t + 1, tier->pending);
+    }
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+/* Append one sample to the finest tier */
+void HistoryRecord(History *h, const float values[HIST_SERIES_COUNT]) {
+    assert(h != NULL && values != NULL);
+
+    HistoryBucket b[HIST_SERIES_COUNT];
+    for (int s = 0; s < HIST_SERIES_COUNT; s++) {
+        b[s] = (HistoryBucket){ values[s], values[s], values[s] };
+    }
+    TierPush(h, 0, b);
+    h->samples++;
+}
+
+int HistoryChartTier(const History *h) {
     assert(h != NULL);
 
-    h->population[h->head]    = population;
-    h->food[h->head]          = food;
-    h->avgSpeed[h->head]      = avgSpeed;
-    h->avgMetabolism[h->head] = avgMetabolism;
+    /* A tier that has never wrapped still holds everything since tick 0,
+       lagging by at most one partial bucket */
+    for (int t = 0; t < HISTORY_TIERS; t++) {
+        if (h->tiers[t].count < HISTORY_TIER_LEN) return t;
+    }
+    return HISTORY_TIERS - 1;
+}
+
+float HistoryChartMax(const History *h, HistorySeries series) {
+    assert(h != NULL && series >= 0 && series < HIST_SERIES_COUNT);
 
-    h->head = (h->head + 1) % HISTORY_LEN;
-    if (h->count < HISTORY_LEN) {
-        h->count++;
+    const HistoryTier *tier = &h->tiers[HistoryChartTier(h)];
+    float peak = 0.0f;
+    for (int i = 0; i < tier->count; i++) {
+        if (tier->data[series][i].max > peak) peak = tier->data[series][i].max;
     }
+    return peak;
 }
@@ -1,36 +1,66 @@
 #include "raylib.h"
-#include "raymath.h"
 #include "config.h"
 #include "simulation.h"
 #include "settings.h"
 #include "ui.h"
 #include "nn_view.h"
+#include "workers.h"
+#include "activation.h"
+#include "benchmark.h"
 
-int main(void) {
+int main(int argc, char **argv) {
     /* ── Init ─────────────────────────────────────────────────── */
+    SimParams params;
+    SimParamsDefault(&params);
+    if (!SimParamsParseArgs(&params, argc, argv)) return 1;
+
+    /* Activation backend is fixed for the whole run */
+    ActivationSetMode((ActivationMode)params.activations);
+    if (params.activationReport) {
+        ActivationReport(stdout);
+        return 0;
+    }
+
     SetRandomSeed(42);
 
+    /* Headless benchmark mode — no window */
+    if (params.benchmarkTicks > 0) {
+        WorkersInit(params.threads);
+        BenchmarkRun(&params, params.benchmarkTicks);
+        WorkersShutdown();
+        return 0;
+    }
+
     InitWindow(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE);
     SetWindowState(FLAG_WINDOW_RESIZABLE);
     SetTargetFPS(TARGET_FPS);
 
+    /* Worker pool for the strip-parallel simulation phases */
+    WorkersInit(params.threads);
+
+    /* Static: the history tiers make Simulation ~440 KB, too big for the stack */
     static Simulation sim;
-    SimulationInit(&sim);
+    SimulationInit(&sim, &params);
+
+    /* Cached render textures for the world background and food */
+    WorldLayers layers;
+    WorldLayersInit(&layers, &sim.world);
 
     SimSettings settings;
     SimSettingsDefault(&settings);
 
     /* Camera starts zoomed to fit the whole world in the viewport */
     Camera2D camera = { 0 };
-    camera.target = (Vector2){ WORLD_WIDTH * 0.5f, WORLD_HEIGHT * 0.5f };
+    camera.target = (Vector2){ sim.world.width * 0.5f, sim.world.height * 0.5f };
     {
         int vpW = GetScreenWidth() - UI_PANEL_WIDTH;
         int vpH = GetScreenHeight();
         camera.offset = (Vector2){ vpW * 0.5f, vpH * 0.5f };
-        camera.zoom   = (float)vpW / WORLD_WIDTH;
+        camera.zoom   = (float)vpW / sim.world.width;
     }
 
     int selectedIdx = -1;   /* index into sim.creatures, -1 = none */
+    int selectedId  = -1;   /* its creature id — the slot may be reused */
     int lastVpW = 0, lastVpH = 0;
 
     /* ── Main loop ────────────────────────────────────────────── */
@@ -72,45 +102,56 @@ int main(void) {
             camera.target.y -= delta.y / camera.zoom;
         }
 
-        /* Left-click in viewport: select nearest creature */
+        /* Left-click in viewport: select nearest creature (pick radius scales
+           with zoom; -1 if clicked empty space) */
         if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && mouse.x < vpW) {
             Vector2 worldPos = GetScreenToWorld2D(mouse, camera);
-            int    bestIdx  = -1;
-            float  bestDist = 20.0f / camera.zoom;   /* pick radius scales with zoom */
-            for (int i = 0; i < sim.creatureCount; i++) {
-                if (!sim.creatures[i].alive) continue;
-                float d = Vector2Distance(worldPos, sim.creatures[i].position);
-                if (d < bestDist) { bestDist = d; bestIdx = i; }
-            }
-            selectedIdx = bestIdx;   /* -1 if clicked empty space */
+            selectedIdx = SimulationPick(&sim, worldPos, 20.0f / camera.zoom);
+            if (selectedIdx >= 0) selectedId = sim.creatures[selectedIdx].id;
         }
 
-        /* Invalidate selection if creature died */
-        if (selectedIdx >= 0 && !sim.creatures[selectedIdx].alive)
-            selectedIdx = -1;
-
         /* ── Update ───────────────────────────────────────────── */
+        if (settings.outbreakSeeds > 0) {
+            SimulationInfect(&sim, settings.outbreakSeeds);
+            settings.outbreakSeeds = 0;
+        }
         if (!settings.paused) {
-            int   steps  = settings.speedMult;
-            float stepDt = GetFrameTime();
+            int    steps  = settings.speedMult;
+            float  stepDt = GetFrameTime();
+            double t0     = GetTime();
             for (int i = 0; i < steps; i++) {
                 SimulationUpdate(&sim, stepDt, &settings);
             }
+            SimSettingsAdaptSensing(&settings, (float)(GetTime() - t0));
         }
 
+        /* Invalidate selection if creature died — after the update, since a
+           retired slot's genome handle is already released and a birth may
+           have reused the slot */
+        if (selectedIdx >= 0 && (!sim.creatures[selectedIdx].alive ||
+                                 sim.creatures[selectedIdx].id != selectedId))
+            selectedIdx = -1;
+
+        /* World-space rectangle visible in the viewport, for draw culling */
+        Vector2 viewMin = GetScreenToWorld2D((Vector2){ 0.0f, 0.0f }, camera);
+        Vector2 viewMax = GetScreenToWorld2D((Vector2){ (float)vpW, (float)vpH }, camera);
+        Rectangle view  = { viewMin.x, viewMin.y, viewMax.x - viewMin.x, viewMax.y - viewMin.y };
+
         /* ── Draw ─────────────────────────────────────────────── */
+        WorldLayersSync(&layers, &sim.world);   /* patch food cells changed this frame */
+
         BeginDrawing();
             ClearBackground(BLACK);
 
             /* World — clipped to viewport */
             BeginScissorMode(0, 0, vpW, vpH);
                 BeginMode2D(camera);
-                    SimulationDraw(&sim);
+                    SimulationDraw(&sim, &layers, view, camera.zoom);
                 EndMode2D();
 
                 /* NN inspector overlay (screen-space, inside scissor) */
                 if (selectedIdx >= 0)
-                    NNViewDraw(&sim.creatures[selectedIdx]);
+                    NNViewDraw(&sim.creatures[selectedIdx], sim.sensors);
 
             EndScissorMode();
 
@@ -127,6 +168,9 @@ int main(void) {
         EndDrawing();
     }
 
+    WorldLayersFree(&layers);
+    SimulationFree(&sim);
+    WorkersShutdown();
     CloseWindow();
     return 0;
 }
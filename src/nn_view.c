@@ -3,6 +3,7 @@
 #include "config.h"
 
 #include <math.h>
+#include <stdio.h>
 #include "raymath.h"
 
 /* ── Layout constants ────────────────────────────────────────── */
@@ -10,7 +11,8 @@
 #define PANEL_Y      10
 #define PANEL_W     370
 #define NODE_R       11
-#define NODES_H     300   /* height of the node-drawing area */
+#define NODE_PITCH   30   /* min px between input node centres */
+#define NODES_H     (NN_INPUTS * NODE_PITCH > 300 ? NN_INPUTS * NODE_PITCH : 300)  /* node-drawing area */
 #define HEADER_PAD    6   /* top padding inside panel */
 #define ROW_H        15   /* pixels between text baseline rows */
 #define SEP_PAD       4   /* gap above/below separator line */
@@ -22,6 +24,14 @@
 #define COL_HID    185
 #define COL_OUT    300
 
+/* Large hidden layers wrap into up to HID_COLS_MAX sub-columns spread over
+   HID_SPAN px around COL_HID; nodes shrink once even that is crowded, and
+   per-node text is only drawn at full size. */
+#define HID_PITCH    26   /* min px between hidden node centres at full size */
+#define HID_COLS_MAX  5
+#define HID_SPAN    140
+#define NODE_R_MIN    2.0f
+
 /* ── Helpers ─────────────────────────────────────────────────── */
 
 /* Compute the y-centre of node slot `idx` out of `total` within the node area. */
@@ -31,6 +41,54 @@ static Vector2 NodePos(int col, int idx, int total, int nodeAreaTop) {
     return (Vector2){ (float)(PANEL_X + col), y };
 }
 
+/* Lay out hidCount hidden nodes in the node area; returns the node radius */
+static float HiddenLayout(int hidCount, int nodeAreaTop, Vector2 *pos) {
+    int perCol = NODES_H / HID_PITCH;
+    int cols   = (hidCount + perCol - 1) / perCol;
+    if (cols > HID_COLS_MAX) {
+        cols   = HID_COLS_MAX;
+        perCol = (hidCount + cols - 1) / cols;
+    }
+    if (cols < 1) cols = 1;
+
+    float colStep = cols > 1 ? (float)HID_SPAN / (float)(cols - 1) : 0.0f;
+    for (int h = 0; h < hidCount; h++) {
+        int col   = h / perCol;
+        int inCol = col < cols - 1 ? perCol : hidCount - col * perCol;
+        pos[h]    = NodePos(COL_HID, h % perCol, inCol, nodeAreaTop);
+        if (cols > 1) pos[h].x += -0.5f * HID_SPAN + colStep * (float)col;
+    }
+
+    float pitch = (float)NODES_H / (float)perCol;
+    if (cols > 1 && colStep < pitch) pitch = colStep;
+    float r = pitch * 0.42f;
+    return r > NODE_R ? NODE_R : (r < NODE_R_MIN ? NODE_R_MIN : r);
+}
+
+/* Fill in the input labels for a sensor model (layout as in config.h):
+   "Food1 d", "Food1 sin", … or "Ray1 d", "Ray1 hit", …; sensor slots the
+   model leaves unused read "-"; then energy and bias. */
+static void BuildInputLabels(char labels[NN_INPUTS][12], SensorMode sensors) {
+    int n = 0;
+    if (sensors == SENSORS_RAYS) {
+        for (int r = 0; r < SENSE_RAYS_MAX; r++) {
+            snprintf(labels[n++], 12, "Ray%d d", r + 1);
+            snprintf(labels[n++], 12, "Ray%d hit", r + 1);
+        }
+    } else {
+        static const char *part[SENSE_TARGET_INPUTS] = { "d", "sin", "cos" };
+        for (int k = 0; k < SENSE_FOOD_K; k++)
+            for (int p = 0; p < SENSE_TARGET_INPUTS; p++)
+                snprintf(labels[n++], 12, "Food%d %s", k + 1, part[p]);
+        for (int k = 0; k < SENSE_CREATURE_K; k++)
+            for (int p = 0; p < SENSE_TARGET_INPUTS; p++)
+                snprintf(labels[n++], 12, "Crt%d %s", k + 1, part[p]);
+    }
+    while (n < SENSE_INPUTS) snprintf(labels[n++], 12, "-");
+    snprintf(labels[n++], 12, "Energy");
+    snprintf(labels[n++], 12, "Bias");
+}
+
 /* Map an activation value → color: dim gray at 0, bright cyan-white as |val| grows */
 static Color NodeColor(float val) {
     float t = tanhf(fabsf(val));
@@ -57,17 +115,18 @@ static void DrawEdge(Vector2 a, Vector2 b, float weight) {
 
 /* ── Public API ──────────────────────────────────────────────── */
 
-void NNViewDraw(const Creature *c) {
-    static const char *inputLabels[NN_INPUTS] = {
-        "FoodDst", "FoodSin", "FoodCos",
-        "CrtDst",  "CrtSin",
-        "Energy",  "Bias"
-    };
+void NNViewDraw(const Creature *c, SensorMode sensors) {
+    static char inputLabels[NN_INPUTS][12];
+    static int  labelsFor = -1;   /* SensorMode the labels were built for */
+    if (labelsFor != (int)sensors) {
+        BuildInputLabels(inputLabels, sensors);
+        labelsFor = (int)sensors;
+    }
     static const char *outputLabels[NN_OUTPUTS] = {
         "Thrust", "Turn", "Repro"
     };
 
-    const Genome *g   = &c->genome;
+    const Genome *g   = c->genome;
     int  hidCount     = g->hiddenCount;
     bool hasHidden    = (hidCount > 0);
     float fovDeg      = c->visionAngle * RAD2DEG;
@@ -148,11 +207,11 @@ void NNViewDraw(const Creature *c) {
 
     /* ── Precompute node screen positions ────────────────────── */
     Vector2 inPos[NN_INPUTS];
-    Vector2 hidPos[NN_HIDDEN_MAX];
+    Vector2 hidPos[NN_HIDDEN_LIMIT];
     Vector2 outPos[NN_OUTPUTS];
 
     for (int i = 0; i < NN_INPUTS;  i++) inPos[i]  = NodePos(COL_IN,  i, NN_INPUTS,  nodeAreaTop);
-    for (int h = 0; h < hidCount;   h++) hidPos[h]  = NodePos(COL_HID, h, hidCount,   nodeAreaTop);
+    float hidR = HiddenLayout(hidCount, nodeAreaTop, hidPos);
     for (int o = 0; o < NN_OUTPUTS; o++) outPos[o]  = NodePos(COL_OUT, o, NN_OUTPUTS, nodeAreaTop);
 
     /* Global node index → screen position lookup */
@@ -165,7 +224,7 @@ void NNViewDraw(const Creature *c) {
     for (int ci = 0; ci < g->connCount; ci++) {
         int   fromNode = g->conns[ci].from;
         int   toNode   = g->conns[ci].to;
-        float weight   = g->conns[ci].weight;
+        float weight   = NNConnWeight(&g->conns[ci]);
 
         bool fromValid = (fromNode < NN_INPUTS) ||
                          (fromNode >= NN_NODE_HIDDEN_BASE &&
@@ -193,11 +252,18 @@ void NNViewDraw(const Creature *c) {
     }
 
     /* ── Hidden nodes ────────────────────────────────────────── */
+    /* Hidden activations aren't stored per creature; re-evaluating the
+       genome on the last inputs reproduces them exactly */
+    static float hidden[NN_HIDDEN_LIMIT];
+    float        outputs[NN_OUTPUTS];
+    GenomeEvalNN(g, c->nnInputs, hidden, outputs);
+
     for (int h = 0; h < hidCount; h++) {
-        float val      = c->hiddenOut[h];
-        ActivationFunc act = g->hiddenAct[h];
-        DrawCircleV(hidPos[h], NODE_R, NodeColor(val));
-        DrawCircleLinesV(hidPos[h], NODE_R, (Color){ 160, 160, 200, 180 });
+        float val      = hidden[h];
+        ActivationFunc act = GenomeHiddenAct(g, h);
+        DrawCircleV(hidPos[h], hidR, NodeColor(val));
+        DrawCircleLinesV(hidPos[h], hidR, (Color){ 160, 160, 200, 180 });
+        if (hidR < NODE_R) continue;
         DrawText(ActivationFuncName(act),
                  (int)(hidPos[h].x - 14), (int)(hidPos[h].y - 5), 8,
                  (Color){ 220, 220, 180, 230 });
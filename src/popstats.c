@@ -0,0 +1,132 @@
+#include "popstats.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stddef.h>
+
+/* ── Trait table ─────────────────────────────────────────────── */
+
+/* Histogram ranges follow the clamps in genome.c. Vision and the network
+   size are uncapped, so their ranges are generous display windows —
+   outliers pile into the last bin. */
+static const struct {
+    const char *name;
+    float       lo, hi;
+} s_traits[TRAIT_COUNT] = {
+    [TRAIT_SIZE]          = { "Size",        3.0f,  12.0f },
+    [TRAIT_SPEED]         = { "Speed",      20.0f, 120.0f },
+    [TRAIT_VISION]        = { "Vision",      0.0f, 600.0f },
+    [TRAIT_VISION_ANGLE]  = { "FOV",         0.0f,  3.14159265f },
+    [TRAIT_METABOLISM]    = { "Metabolism",  1.0f,   8.0f },
+    [TRAIT_LIFESPAN]      = { "Lifespan",   60.0f, 600.0f },
+    [TRAIT_MUTATION_RATE] = { "MutRate",     0.0f,   0.5f },
+    [TRAIT_RAYS]          = { "Rays",        1.0f, (float)SENSE_RAYS_MAX },
+    [TRAIT_CARNIVORY]     = { "Carnivory",   0.0f,   1.0f },
+    [TRAIT_HIDDEN_COUNT]  = { "Hidden",      0.0f,  32.0f },
+    [TRAIT_CONN_COUNT]    = { "Conns",       0.0f, 256.0f },
+};
+
+/* ── Internal helpers ────────────────────────────────────────── */
+
+static float TraitValue(const Genome *g, Trait t) {
+    switch (t) {
+        case TRAIT_SIZE:          return g->size;
+        case TRAIT_SPEED:         return g->speed;
+        case TRAIT_VISION:        return g->vision;
+        case TRAIT_VISION_ANGLE:  return g->visionAngle;
+        case TRAIT_METABOLISM:    return g->metabolism;
+        case TRAIT_LIFESPAN:      return g->lifespan;
+        case TRAIT_MUTATION_RATE: return g->mutationRate;
+        case TRAIT_RAYS:          return g->rays;
+        case TRAIT_CARNIVORY:     return g->carnivory;
+        case TRAIT_HIDDEN_COUNT:  return (float)g->hiddenCount;
+        case TRAIT_CONN_COUNT:    return (float)g->connCount;
+        default:                  return 0.0f;
+    }
+}
+
+static int TraitBin(Trait t, float v) {
+    float norm = (v - s_traits[t].lo) / (s_traits[t].hi - s_traits[t].lo);
+    int   bin  = (int)(norm * POPSTATS_BINS);
+    if (bin < 0)              bin = 0;
+    if (bin >= POPSTATS_BINS) bin = POPSTATS_BINS - 1;
+    return bin;
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+void PopStatsAdd(PopStats *p, const Genome *g) {
+    assert(p != NULL && g != NULL);
+    for (int t = 0; t < TRAIT_COUNT; t++) {
+        float v = TraitValue(g, (Trait)t);
+        p->traits[t].sum   += v;
+        p->traits[t].sumSq += (double)v * v;
+        p->traits[t].bins[TraitBin((Trait)t, v)]++;
+    }
+    p->count++;
+}
+
+void PopStatsRemove(PopStats *p, const Genome *g) {
+    assert(p != NULL && g != NULL && p->count > 0);
+    for (int t = 0; t < TRAIT_COUNT; t++) {
+        float v   = TraitValue(g, (Trait)t);
+        int   bin = TraitBin((Trait)t, v);
+        assert(p->traits[t].bins[bin] > 0);
+        p->traits[t].sum   -= v;
+        p->traits[t].sumSq -= (double)v * v;
+        p->traits[t].bins[bin]--;
+    }
+    /* Reset sums when the population empties so rounding drift can't linger */
+    if (--p->count == 0) {
+        for (int t = 0; t < TRAIT_COUNT; t++) {
+            p->traits[t].sum   = 0.0;
+            p->traits[t].sumSq = 0.0;
+        }
+    }
+}
+
+float PopStatsMean(const PopStats *p, Trait t) {
+    assert(p != NULL && t >= 0 && t < TRAIT_COUNT);
+    if (p->count == 0) return 0.0f;
+    return (float)(p->traits[t].sum / p->count);
+}
+
+float PopStatsStdDev(const PopStats *p, Trait t) {
+    assert(p != NULL && t >= 0 && t < TRAIT_COUNT);
+    if (p->count < 2) return 0.0f;
+    double mean = p->traits[t].sum / p->count;
+    double var  = p->traits[t].sumSq / p->count - mean * mean;
+    return var > 0.0 ? (float)sqrt(var) : 0.0f;
+}
+
+float PopStatsQuantile(const PopStats *p, Trait t, float q) {
+    assert(p != NULL && t >= 0 && t < TRAIT_COUNT);
+    if (p->count == 0) return 0.0f;
+    if (q < 0.0f) q = 0.0f;
+    if (q > 1.0f) q = 1.0f;
+
+    const int *bins   = p->traits[t].bins;
+    float      binW   = (s_traits[t].hi - s_traits[t].lo) / POPSTATS_BINS;
+    float      target = q * (float)p->count;
+    int        cum    = 0;
+
+    for (int b = 0; b < POPSTATS_BINS; b++) {
+        if (bins[b] > 0 && (float)(cum + bins[b]) >= target) {
+            float frac = (target - (float)cum) / (float)bins[b];
+            return s_traits[t].lo + ((float)b + frac) * binW;
+        }
+        cum += bins[b];
+    }
+    return s_traits[t].hi;
+}
+
+void TraitRange(Trait t, float *lo, float *hi) {
+    assert(t >= 0 && t < TRAIT_COUNT && lo != NULL && hi != NULL);
+    *lo = s_traits[t].lo;
+    *hi = s_traits[t].hi;
+}
+
+const char *TraitName(Trait t) {
+    assert(t >= 0 && t < TRAIT_COUNT);
+    return s_traits[t].name;
+}
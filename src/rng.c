@@ -0,0 +1,76 @@
+#include "rng.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "raylib.h"
+
+/* ── Internal helpers ────────────────────────────────────────── */
+
+/* RAND_LANES independent xoshiro128+ streams stepped in lockstep: the state
+   is laid out lane-minor so each step is a handful of element-wise integer
+   ops the compiler turns into SIMD. Uniforms are produced RAND_BLOCK at a
+   time and handed out from a buffer. Seeded once from raylib's generator so
+   SetRandomSeed still pins a run. */
+#define RAND_LANES   8
+#define RAND_BLOCK  (RAND_LANES * 16)
+
+static uint32_t s_rngState[4][RAND_LANES];
+static float    s_rngBuf[RAND_BLOCK];
+static int      s_rngPos = RAND_BLOCK;
+static bool     s_rngSeeded = false;
+
+static void RandRefill(void) {
+    if (!s_rngSeeded) {
+        for (int k = 0; k < 4; k++) {
+            for (int l = 0; l < RAND_LANES; l++) {
+                /* 2×15 bits per word keeps this independent of RAND_MAX-style limits */
+                s_rngState[k][l] = ((uint32_t)GetRandomValue(0, 0x7FFF) << 17)
+                                 ^ ((uint32_t)GetRandomValue(0, 0x7FFF) << 2)
+                                 ^ (uint32_t)(k * RAND_LANES + l + 1);
+            }
+        }
+        s_rngSeeded = true;
+    }
+
+    for (int base = 0; base < RAND_BLOCK; base += RAND_LANES) {
+        uint32_t *s0 = s_rngState[0], *s1 = s_rngState[1], *s2 = s_rngState[2], *s3 = s_rngState[3];
+        for (int l = 0; l < RAND_LANES; l++) {
+            uint32_t result = s0[l] + s3[l];
+            uint32_t t      = s1[l] << 9;
+            s2[l] ^= s0[l];
+            s3[l] ^= s1[l];
+            s1[l] ^= s2[l];
+            s0[l] ^= s3[l];
+            s2[l] ^= t;
+            s3[l]  = (s3[l] << 11) | (s3[l] >> 21);
+            /* Top 24 bits → float in [0, 1) */
+            s_rngBuf[base + l] = (float)(result >> 8) * (1.0f / 16777216.0f);
+        }
+    }
+    s_rngPos = 0;
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+void RngUniforms(float *out, int n) {
+    while (n > 0) {
+        if (s_rngPos == RAND_BLOCK) RandRefill();
+        int take = RAND_BLOCK - s_rngPos;
+        if (take > n) take = n;
+        memcpy(out, s_rngBuf + s_rngPos, (size_t)take * sizeof(*out));
+        s_rngPos += take;
+        out      += take;
+        n        -= take;
+    }
+}
+
+float RngFloat(void) {
+    if (s_rngPos == RAND_BLOCK) RandRefill();
+    return s_rngBuf[s_rngPos++];
+}
+
+void RngReseed(void) {
+    s_rngSeeded = false;
+    s_rngPos    = RAND_BLOCK;
+}
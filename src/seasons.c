@@ -0,0 +1,20 @@
+#include "seasons.h"
+#include "config.h"
+
+#include <assert.h>
+
+/* Spring growth, summer abundance, autumn decline, winter scarcity. Winter's
+   low cap stops plant spawning until creatures have eaten the stock down. */
+static const Season s_seasons[SEASON_COUNT] = {
+    { "Spring", 1.5f, 1.0f },
+    { "Summer", 1.0f, 1.2f },
+    { "Autumn", 0.7f, 0.9f },
+    { "Winter", 0.3f, 0.6f },
+};
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+const Season *SeasonAt(int tick) {
+    assert(tick >= 0);
+    return &s_seasons[tick / SEASON_TICKS % SEASON_COUNT];
+}
@@ -1,5 +1,14 @@
 #include "settings.h"
 #include "config.h"
+#include "popstats.h"
+#include "activation.h"
+#include "creature.h"
+#include "cell_table.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 /* Initialize settings to sensible defaults */
 void SimSettingsDefault(SimSettings *s) {
@@ -9,4 +18,149 @@ void SimSettingsDefault(SimSettings *s) {
     s->foodSpawnRate = FOOD_SPAWN_RATE;
     s->mutRateMult   = 1.0f;
     s->minPopulation = 50;
+    s->chartTrait    = TRAIT_SPEED;
+    s->staggerSensing = false;
+    s->senseCohorts   = 1;
+    s->simFrameTime   = 0.0f;
+    s->collisions     = true;
+    s->sexual         = true;
+    s->seasons        = true;
+    s->outbreaks      = true;
+    s->outbreakSeeds  = 0;
+}
+
+void SimSettingsAdaptSensing(SimSettings *s, float simSeconds) {
+    /* Exponential moving average so one slow frame doesn't flip K */
+    s->simFrameTime += (simSeconds - s->simFrameTime) * 0.1f;
+
+    if (!s->staggerSensing) {
+        s->senseCohorts = 1;
+        return;
+    }
+    if (s->simFrameTime > SENSE_FRAME_BUDGET && s->senseCohorts < SENSE_COHORTS_MAX) {
+        s->senseCohorts *= 2;
+        s->simFrameTime *= 0.5f;   /* expect roughly halved sensing cost; re-measure from there */
+    } else if (s->simFrameTime < SENSE_FRAME_BUDGET * 0.4f && s->senseCohorts > 1) {
+        s->senseCohorts /= 2;
+        s->simFrameTime *= 1.5f;
+    }
+}
+
+void SimParamsDefault(SimParams *p) {
+    p->worldWidth   = WORLD_WIDTH;
+    p->worldHeight  = WORLD_HEIGHT;
+    p->maxCreatures = MAX_CREATURES;
+    p->maxFood      = MAX_FOOD;
+    p->threads      = 0;
+    p->activations  = ACTIVATION_EXACT;
+    p->sensors      = SENSORS_CONE;
+    p->grid         = CELL_TABLE_AUTO;
+    p->fertility    = "noise";
+    p->activationReport = false;
+    p->benchmarkTicks   = 0;
+}
+
+/* Round a world dimension up to whole grid cells (at least one) */
+static int RoundToCells(int v) {
+    if (v < GRID_CELL_SIZE) v = GRID_CELL_SIZE;
+    return (v + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE * GRID_CELL_SIZE;
+}
+
+static void PrintUsage(const char *exe) {
+    fprintf(stderr,
+            "usage: %s [--world-width PX] [--world-height PX] [--max-creatures N]\n"
+            "          (width/200 x height/200 grid cells must fit in an int)\n"
+            "          [--max-food N] [--threads N (0 = all cores)]\n"
+            "          [--activations exact|fast] [--activation-report]\n"
+            "          [--sensors cone|rays] [--grid auto|dense|hash]\n"
+            "          [--fertility noise|flat|FILE.png]\n"
+            "          [--benchmark TICKS]\n",
+            exe);
+}
+
+bool SimParamsParseArgs(SimParams *p, int argc, char **argv) {
+    static const struct { const char *flag; int minValue; } flags[] = {
+        { "--world-width",   1 },
+        { "--world-height",  1 },
+        { "--max-creatures", 1 },
+        { "--max-food",      1 },
+        { "--threads",       0 },
+        { "--benchmark",     1 },
+    };
+    int *targets[] = { &p->worldWidth, &p->worldHeight, &p->maxCreatures, &p->maxFood, &p->threads,
+                       &p->benchmarkTicks };
+    const int flagCount = (int)(sizeof(flags) / sizeof(flags[0]));
+
+    for (int a = 1; a < argc; a++) {
+        /* Non-numeric flags */
+        if (strcmp(argv[a], "--activation-report") == 0) {
+            p->activationReport = true;
+            continue;
+        }
+        if (strcmp(argv[a], "--activations") == 0 && a + 1 < argc) {
+            if      (strcmp(argv[a + 1], "exact") == 0) p->activations = ACTIVATION_EXACT;
+            else if (strcmp(argv[a + 1], "fast")  == 0) p->activations = ACTIVATION_FAST;
+            else {
+                PrintUsage(argv[0]);
+                return false;
+            }
+            a++;
+            continue;
+        }
+        if (strcmp(argv[a], "--sensors") == 0 && a + 1 < argc) {
+            if      (strcmp(argv[a + 1], "cone") == 0) p->sensors = SENSORS_CONE;
+            else if (strcmp(argv[a + 1], "rays") == 0) p->sensors = SENSORS_RAYS;
+            else {
+                PrintUsage(argv[0]);
+                return false;
+            }
+            a++;
+            continue;
+        }
+
+        if (strcmp(argv[a], "--grid") == 0 && a + 1 < argc) {
+            if      (strcmp(argv[a + 1], "auto")  == 0) p->grid = CELL_TABLE_AUTO;
+            else if (strcmp(argv[a + 1], "dense") == 0) p->grid = CELL_TABLE_DENSE;
+            else if (strcmp(argv[a + 1], "hash")  == 0) p->grid = CELL_TABLE_HASHED;
+            else {
+                PrintUsage(argv[0]);
+                return false;
+            }
+            a++;
+            continue;
+        }
+        if (strcmp(argv[a], "--fertility") == 0 && a + 1 < argc) {
+            p->fertility = argv[++a];
+            continue;
+        }
+
+        int f = 0;
+        while (f < flagCount && strcmp(argv[a], flags[f].flag) != 0) f++;
+        if (f == flagCount || a + 1 >= argc) {
+            PrintUsage(argv[0]);
+            return false;
+        }
+
+        char *end;
+        long  value = strtol(argv[a + 1], &end, 10);
+        if (end == argv[a + 1] || *end != '\0' || value < flags[f].minValue || value > 1000000000L) {
+            PrintUsage(argv[0]);
+            return false;
+        }
+        *targets[f] = (int)value;
+        a++;
+    }
+
+    p->worldWidth  = RoundToCells(p->worldWidth);
+    p->worldHeight = RoundToCells(p->worldHeight);
+
+    /* Cell indices are int throughout the grids and maps */
+    long long cells = (long long)(p->worldWidth / GRID_CELL_SIZE) * (p->worldHeight / GRID_CELL_SIZE);
+    if (cells > INT_MAX) {
+        fprintf(stderr, "world of %d x %d px has %lld grid cells, at most %d allowed\n",
+                p->worldWidth, p->worldHeight, cells, INT_MAX);
+        PrintUsage(argv[0]);
+        return false;
+    }
+    return true;
 }
@@ -1,334 +1,986 @@
 #include "simulation.h"
+#include "domain.h"
+#include "timing.h"
 
 #include <math.h>
 #include "raymath.h"
+#include "rlgl.h"
 #include <assert.h>
+#include <float.h>
+#include <stdlib.h>
 #include <string.h>
 
-/* ── Creature spatial grid (rebuilt every frame) ─────────────── */
-/* Static storage avoids large stack frames and heap allocation.  */
-static int s_crGridHead[GRID_CELL_COUNT];  /* per-cell list head (-1 = empty) */
-static int s_crGridNext[MAX_CREATURES];    /* next creature in same cell       */
+_Static_assert(SENSE_FOOD_K <= SPATIAL_NEAREST_MAX && SENSE_CREATURE_K <= SPATIAL_NEAREST_MAX,
+               "k-nearest sensors are bounded by SPATIAL_NEAREST_MAX");
+
+/* Grow the creature pool geometrically so it holds at least `need` slots
+   (never beyond maxCreatures). Invalidates pointers into s->creatures.
+   Returns false if the pool is already at maxCreatures. */
+static bool GrowCreaturePool(Simulation *s, int need) {
+    if (need <= s->creatureCap) return true;
+    if (s->creatureCap >= s->maxCreatures) return false;
+
+    int cap = s->creatureCap > 0 ? s->creatureCap : POOL_INITIAL_CAPACITY;
+    while (cap < need) cap *= 2;
+    if (cap > s->maxCreatures) cap = s->maxCreatures;
+
+    Creature *creatures = realloc(s->creatures,  (size_t)cap * sizeof(*s->creatures));
+    int      *freeSlots = realloc(s->freeSlots,  (size_t)cap * sizeof(*s->freeSlots));
+    int      *eaten     = realloc(s->eatenFood, (size_t)cap * sizeof(*s->eatenFood));
+    NbrList  *nbr       = realloc(s->nbr,        (size_t)cap * sizeof(*s->nbr));
+    int      *crossed   = realloc(s->crossed,    (size_t)cap * sizeof(*s->crossed));
+    int      *preyOf    = realloc(s->preyOf,     (size_t)cap * sizeof(*s->preyOf));
+    int      *claimedBy = realloc(s->claimedBy,  (size_t)cap * sizeof(*s->claimedBy));
+    int      *mateOf    = realloc(s->mateOf,     (size_t)cap * sizeof(*s->mateOf));
+    float    *pushX     = realloc(s->pushX,      (size_t)cap * sizeof(*s->pushX));
+    float    *pushY     = realloc(s->pushY,      (size_t)cap * sizeof(*s->pushY));
+    int      *sick      = realloc(s->sick,       (size_t)cap * sizeof(*s->sick));
+    if (creatures) s->creatures  = creatures;
+    if (freeSlots) s->freeSlots  = freeSlots;
+    if (eaten)     s->eatenFood = eaten;
+    if (nbr)       s->nbr        = nbr;
+    if (crossed)   s->crossed    = crossed;
+    if (preyOf)    s->preyOf     = preyOf;
+    if (claimedBy) s->claimedBy  = claimedBy;
+    if (mateOf)    s->mateOf     = mateOf;
+    if (pushX)     s->pushX      = pushX;
+    if (pushY)     s->pushY      = pushY;
+    if (sick)      s->sick       = sick;
+    if (!creatures || !freeSlots || !eaten || !nbr || !crossed || !preyOf || !claimedBy || !mateOf || !pushX || !pushY || !sick) TraceLog(LOG_FATAL, "SIM: out of memory growing creature pool to %d", cap);
+    memset(s->nbr + s->creatureCap, 0, (size_t)(cap - s->creatureCap) * sizeof(*s->nbr));
+    memset(s->claimedBy + s->creatureCap, -1, (size_t)(cap - s->creatureCap) * sizeof(*s->claimedBy));
+    SpatialReserve(&s->crGrid, cap);
+    SpatialBind(&s->crGrid, &s->creatures->position, sizeof(*s->creatures));
+
+    s->creatureCap = cap;
+    return true;
+}
+
+/* Find a slot for a new creature: a recycled dead slot first (O(1) pop),
+   then extend the array, growing the pool if needed. Returns -1 if the
+   population cap is reached. May invalidate pointers into s->creatures. */
+static int AllocCreatureSlot(Simulation *s) {
+    if (s->freeCount > 0) return s->freeSlots[--s->freeCount];
+    if (!GrowCreaturePool(s, s->creatureCount + 1)) return -1;
+    return s->creatureCount++;
+}
+
+/* Initialize the creature in `slot` with pool genome `genomeId`, taking over
+   the caller's reference, and update bookkeeping that depends on the genome
+   (the draw-culling vision bound, population statistics, species membership).
+   parent is NULL for spontaneous spawns; a child that shares its parent's
+   genome joins the parent's species without a distance check. */
+static void SpawnCreature(Simulation *s, int slot, Vector2 pos, int genomeId, const Creature *parent) {
+    const Genome *genome = GenomePoolGet(&s->genomes, genomeId);
+    Creature     *c      = &s->creatures[slot];
+    CreatureInit(c, s->nextId++, pos, genome);
+    c->genomeId = genomeId;
+    if (genome->vision > s->maxVision) s->maxVision = genome->vision;
+    if (genome->speed  > s->maxSpeed)  s->maxSpeed  = genome->speed;
+    PopStatsAdd(&s->stats, genome);
+
+    SpatialInsert(&s->crGrid, slot);
+
+    /* The slot's old neighbour list and mate choice are stale; others find
+       the newborn in the log */
+    s->nbr[slot].valid   = false;
+    s->nbr[slot].bornSeq = s->birthSeq;
+    s->mateOf[slot]      = -1;
+    s->birthLog[s->birthSeq % NBR_BIRTH_LOG] = slot;
+    s->birthSeq++;
+
+    if (parent && parent->genomeId == genomeId) {
+        c->species = parent->species;
+        SpeciesJoin(&s->species, c->species);
+    } else {
+        c->species = SpeciesAssign(&s->species, genome, parent ? parent->species : -1);
+    }
+}
+
+/* Remove creature i from the sick list (swap with the last entry) */
+static void Cure(Simulation *s, int i) {
+    int k    = s->creatures[i].sickSlot;
+    int last = s->sick[--s->sickCount];
+    s->sick[k] = last;
+    s->creatures[last].sickSlot = k;
+    s->creatures[i].sickSlot    = -1;
+}
+
+/* Release everything a dead creature in slot i holds and queue the slot for
+   reuse. Runs once per death: the age = -1 sentinel marks it as counted. */
+static void RetireCreature(Simulation *s, int i) {
+    Creature *c = &s->creatures[i];
+    if (c->sickSlot >= 0) Cure(s, i);
+    s->totalDeaths++;
+    s->aliveCount--;
+    c->age = -1.0f;
+    PopStatsRemove(&s->stats, c->genome);
+    SpeciesRelease(&s->species, c->species);
+    GenomePoolRelease(&s->genomes, c->genomeId);
+    SpatialUnlink(&s->crGrid, i);
+    s->freeSlots[s->freeCount++] = i;
+}
+
+/* Spawn the child of creatures a and b (b == a: asexual) into `slot`, near
+   the pair. The fitter parent — more energy, the lower slot on ties — lends
+   its topology and species; the mutation rate is its own, scaled by
+   mutRateMult. The child is given REPRODUCE_ENERGY_COST of its parent's
+   energy, split evenly between two parents. An unchanged child shares the
+   fitter parent's pooled genome. */
+static void Breed(Simulation *s, int slot, int a, int b, float mutRateMult) {
+    if (s->creatures[b].energy > s->creatures[a].energy) {
+        int t = a;
+        a = b;
+        b = t;
+    }
+    Creature *pa = &s->creatures[a];
+    Creature *pb = &s->creatures[b];
+
+    /* Near the pair's midpoint */
+    float mx = pa->position.x + 0.5f * TORUS_DELTA(pb->position.x - pa->position.x, s->world.width);
+    float my = pa->position.y + 0.5f * TORUS_DELTA(pb->position.y - pa->position.y, s->world.height);
+    Vector2 childPos = {
+        Clamp(mx + (float)GetRandomValue(-20, 20), pa->size, (float)s->world.width  - pa->size),
+        Clamp(my + (float)GetRandomValue(-20, 20), pa->size, (float)s->world.height - pa->size)
+    };
+
+    float         mutRate = pa->genome->mutationRate * mutRateMult;
+    const Genome *child   = GenomeCrossover(pa->genome, pb->genome, mutRate);
+    int           childId;
+    if (child == pa->genome) {
+        childId = pa->genomeId;
+        GenomePoolRetain(&s->genomes, childId);
+    } else {
+        childId = GenomePoolAdd(&s->genomes, child);
+    }
+    SpawnCreature(s, slot, childPos, childId, pa);
+
+    float share = a == b ? REPRODUCE_ENERGY_COST : REPRODUCE_ENERGY_COST * 0.5f;
+    float gift  = pa->energy * share;
+    pa->energy -= gift;
+    pa->reproductionCooldown = REPRODUCE_COOLDOWN;
+    pa->courting             = 0.0f;
+    if (b != a) {
+        float more = pb->energy * share;
+        pb->energy -= more;
+        pb->reproductionCooldown = REPRODUCE_COOLDOWN;
+        pb->courting             = 0.0f;
+        gift += more;
+        s->sexualBirths++;
+    }
+    s->creatures[slot].energy = gift;
+    s->totalBirths++;
+    s->aliveCount++;
+}
+
+/* Food eaten per strip this tick — settled with WorldFoodRelease after the
+   eat pass. Strip k records the items it ate in s->eatenFood[domain.start[k] ..],
+   which cannot overflow: each creature eats at most one item per tick. */
+static int s_stripEaten[DOMAIN_STRIPS];
+
+/* Creatures per strip whose grid cell changed during movement, recorded in
+   s->crossed[domain.start[k] ..] and relinked serially after the move pass. */
+static int s_stripCrossed[DOMAIN_STRIPS];
+
+/* Touching pairs counted per strip this tick — summed into s->contacts */
+static int s_stripContacts[DOMAIN_STRIPS];
+
+/* Shared context for the per-creature phase callbacks */
+typedef struct {
+    Simulation *s;
+    float       dt;
+    int         senseCohorts;  /* K: creatures re-query the grids every K ticks */
+    int         senseCohort;   /* cohort (id % K) that re-queries this tick */
+    bool        sexual;        /* ready creatures choose mates in the contact pass */
+    bool        separate;      /* overlapping bodies are pushed apart in the contact pass */
+} StepCtx;
+
+/* ── Per-creature phase bodies (run by the strip workers) ──── */
+
+/* ── Verlet neighbour lists ──────────────────────────────────── */
+
+/* True while every creature that can be within vision of i is either in its
+   list or in the birth log since the build: i moved at most `own`, any other
+   creature at most maxSpeed × age plus the separation pushes since, and
+   together that is within the skin. */
+static bool NbrListFresh(const Simulation *s, int i) {
+    const NbrList  *l = &s->nbr[i];
+    const Creature *c = &s->creatures[i];
+    if (!l->valid || s->birthSeq - l->birthSeq > NBR_BIRTH_LOG) return false;
+    float dx  = TORUS_DELTA(c->position.x - l->buildPos.x, s->world.width);
+    float dy  = TORUS_DELTA(c->position.y - l->buildPos.y, s->world.height);
+    float own = sqrtf(dx*dx + dy*dy);
+    return own + s->maxSpeed * l->age + (float)(s->pushTravel - l->pushMark) <= NBR_SKIN;
+}
+
+/* Radius query visitor: append creature j to the list being built */
+typedef struct {
+    NbrList *l;
+    int      self;
+} NbrBuild;
+
+static bool AddNeighbour(void *ctx, int j, float dx, float dy, float dSq) {
+    (void)dx; (void)dy; (void)dSq;
+    NbrBuild *b = (NbrBuild *)ctx;
+    NbrList  *l = b->l;
+    if (j == b->self) return false;
+    if (l->count == l->cap) {
+        int  cap = l->cap > 0 ? l->cap * 2 : 16;
+        int *idx = realloc(l->idx, (size_t)cap * sizeof(*l->idx));
+        if (!idx) TraceLog(LOG_FATAL, "SIM: out of memory growing neighbour list to %d", cap);
+        l->idx = idx;
+        l->cap = cap;
+    }
+    l->idx[l->count++] = j;
+    return false;
+}
+
+/* Rebuild creature i's list from the creature grid if it has expired.
+   Touches only nbr[i], so strip workers may call it for their own creatures. */
+static void EnsureNbrList(Simulation *s, int i) {
+    if (NbrListFresh(s, i)) return;
+
+    NbrList        *l = &s->nbr[i];
+    const Creature *c = &s->creatures[i];
+    NbrBuild        b = { l, i };
+    l->count = 0;
+    SpatialQueryRadius(&s->crGrid, c->position, c->vision + NBR_SKIN, NULL, AddNeighbour, &b);
+    l->buildPos = c->position;
+    l->age      = 0.0f;
+    l->birthSeq = s->birthSeq;
+    l->pushMark = s->pushTravel;
+    l->valid    = true;
+}
+
+/* Visit every living candidate neighbour of creature i once: its list,
+   then creatures spawned since the build. A slot reused since the build has
+   a stale list entry and one log entry per rebirth; only its latest birth
+   is visited. Callers apply their own exact range test. EnsureNbrList(i)
+   must have run. */
+static void VisitNeighbours(const Simulation *s, int i, void (*fn)(void *ctx, int j), void *ctx) {
+    const NbrList *l      = &s->nbr[i];
+    unsigned       births = s->birthSeq - l->birthSeq;
+    for (int k = 0; k < l->count; k++) {
+        int j = l->idx[k];
+        if (s->creatures[j].alive && s->nbr[j].bornSeq - l->birthSeq >= births) fn(ctx, j);
+    }
+    for (unsigned q = l->birthSeq; q != s->birthSeq; q++) {
+        int j = s->birthLog[q % NBR_BIRTH_LOG];
+        if (j != i && s->creatures[j].alive && s->nbr[j].bornSeq == q) fn(ctx, j);
+    }
+}
+
+/* ── k-nearest sensor queries ────────────────────────────── */
+
+/* Running k nearest visible creatures for one sensing creature */
+typedef struct {
+    const Simulation *s;
+    const Creature   *c;
+    SpatialCone       cone;
+    float             visionSq;
+    SpatialNearest    heap;
+} NearestCreatureQuery;
+
+static void ConsiderNearestCreature(void *ctx, int j) {
+    NearestCreatureQuery *q = (NearestCreatureQuery *)ctx;
+    const Creature       *c = q->c;
+    float dx = TORUS_DELTA(q->s->creatures[j].position.x - c->position.x, q->s->world.width);
+    float dy = TORUS_DELTA(q->s->creatures[j].position.y - c->position.y, q->s->world.height);
+    float dSq = dx*dx + dy*dy;
+    if (dSq >= SpatialNearestBound(&q->heap, q->visionSq)) return;
+    if (!SpatialInCone(&q->cone, dx, dy)) return;
+    SpatialNearestPush(&q->heap, dSq, j);
+}
+
+/* Full query for creature i: find the k nearest food items (grid) and the
+   k nearest other creatures (Verlet list) inside its vision cone and cache
+   their positions on the creature, nearest first. */
+static void QuerySensors(Simulation *s, int i, Creature *c) {
+    SpatialCone cone     = { c->facing, c->visionAngle };
+    float       visionSq = c->vision * c->vision;
+
+    /* ── Food sensor (grid) ───────────────────────────── */
+    SpatialNearest food = { .k = SENSE_FOOD_K };
+    SpatialQueryNearest(&s->world.foodGrid, c->position, c->vision, &cone, &food);
+    c->foodTargetCount = food.n;
+    for (int k = 0; k < food.n; k++) c->foodTargets[k] = s->world.food[food.idx[k]].position;
+
+    /* ── Other creature sensor (Verlet list) ──────────── */
+    EnsureNbrList(s, i);
+    NearestCreatureQuery q = { s, c, cone, visionSq, { .k = SENSE_CREATURE_K } };
+    VisitNeighbours(s, i, ConsiderNearestCreature, &q);
+
+    SpatialNearestSort(&q.heap);
+    c->crTargetCount = q.heap.n;
+    for (int k = 0; k < q.heap.n; k++) c->crTargets[k] = s->creatures[q.heap.idx[k]].position;
+    c->sensed = true;
+}
+
+/* Write SENSE_TARGET_INPUTS inputs per slot for up to k cached targets:
+   distance / vision, sin and cos of the bearing relative to facing.
+   Targets that have left vision range are dropped from the cache; empty
+   slots read (1, 0, 0). */
+static void TargetInputs(const Simulation *s, const Creature *c, Vector2 *targets,
+                         int *count, int k, float *inputs) {
+    float visionSq = c->vision * c->vision;
+    int   n        = 0;
+    for (int t = 0; t < *count; t++) {
+        float dx  = TORUS_DELTA(targets[t].x - c->position.x, s->world.width);
+        float dy  = TORUS_DELTA(targets[t].y - c->position.y, s->world.height);
+        float dSq = dx*dx + dy*dy;
+        if (dSq > visionSq) continue;
+        float relAngle = atan2f(dy, dx) - c->facing;
+        targets[n] = targets[t];
+        inputs[n * SENSE_TARGET_INPUTS + 0] = sqrtf(dSq) / c->vision;
+        inputs[n * SENSE_TARGET_INPUTS + 1] = sinf(relAngle);
+        inputs[n * SENSE_TARGET_INPUTS + 2] = cosf(relAngle);
+        n++;
+    }
+    *count = n;
+    for (int t = n; t < k; t++) {
+        inputs[t * SENSE_TARGET_INPUTS + 0] = 1.0f;
+        inputs[t * SENSE_TARGET_INPUTS + 1] = 0.0f;
+        inputs[t * SENSE_TARGET_INPUTS + 2] = 0.0f;
+    }
+}
+
+/* ── Raycast sensors (SENSORS_RAYS) ───────────────────────── */
+
+/* Ray parameter at which the unit ray from the origin along dir first enters
+   the circle of radius r around delta (the centre relative to the origin);
+   0 if the origin is inside, < 0 on a miss or when the circle is behind. */
+static inline float RayCircle(float dx, float dy, float dirX, float dirY, float r) {
+    float b = dx * dirX + dy * dirY;
+    float c = dx*dx + dy*dy - r*r;
+    if (c <= 0.0f) return 0.0f;
+    if (b <= 0.0f) return -1.0f;
+    float disc = b*b - c;
+    if (disc < 0.0f) return -1.0f;
+    return b - sqrtf(disc);
+}
+
+/* Trace one ray of length `len` from creature i through the food and
+   creature grids with a DDA cell walk (Amanatides–Woo), testing only objects
+   linked in the cells the ray crosses. Objects are binned by centre, so a
+   body straddling a cell border is seen from the cell holding its centre.
+   Stops at the first cell whose exit lies beyond the best hit so far.
+   Returns the hit distance (len on a miss) and sets *type to +1 food,
+   -1 creature, 0 nothing. */
+static float TraceRay(const Simulation *s, int i, float dirX, float dirY, float len, float *type) {
+    const World    *w = &s->world;
+    const Creature *c = &s->creatures[i];
+    float best = len;
+    *type = 0.0f;
+
+    int   cellX  = (int)floorf(c->position.x / GRID_CELL_SIZE);
+    int   cellY  = (int)floorf(c->position.y / GRID_CELL_SIZE);
+    int   stepX  = dirX > 0.0f ? 1 : -1;
+    int   stepY  = dirY > 0.0f ? 1 : -1;
+    float tDeltaX = dirX != 0.0f ? GRID_CELL_SIZE / fabsf(dirX) : FLT_MAX;
+    float tDeltaY = dirY != 0.0f ? GRID_CELL_SIZE / fabsf(dirY) : FLT_MAX;
+    float tMaxX   = dirX != 0.0f ? ((float)(cellX + (stepX > 0)) * GRID_CELL_SIZE - c->position.x) / dirX : FLT_MAX;
+    float tMaxY   = dirY != 0.0f ? ((float)(cellY + (stepY > 0)) * GRID_CELL_SIZE - c->position.y) / dirY : FLT_MAX;
+
+    /* A ray longer than the world would revisit cells — one lap at most */
+    for (int steps = w->gridCols + w->gridRows; steps > 0; steps--) {
+        int cell = SpatialCellAt(&s->crGrid, cellX, cellY);
+
+        for (int f = SpatialHead(&w->foodGrid, cell); f != -1; f = w->foodGrid.next[f]) {
+            float dx = TORUS_DELTA(w->food[f].position.x - c->position.x, w->width);
+            float dy = TORUS_DELTA(w->food[f].position.y - c->position.y, w->height);
+            float t  = RayCircle(dx, dy, dirX, dirY, FOOD_SIZE);
+            if (t >= 0.0f && t < best) { best = t; *type = 1.0f; }
+        }
+        for (int j = SpatialHead(&s->crGrid, cell); j != -1; j = s->crGrid.next[j]) {
+            if (j == i) continue;
+            float dx = TORUS_DELTA(s->creatures[j].position.x - c->position.x, w->width);
+            float dy = TORUS_DELTA(s->creatures[j].position.y - c->position.y, w->height);
+            float t  = RayCircle(dx, dy, dirX, dirY, s->creatures[j].size);
+            if (t >= 0.0f && t < best) { best = t; *type = -1.0f; }
+        }
+
+        float tExit = tMaxX < tMaxY ? tMaxX : tMaxY;
+        if (best <= tExit) break;
+        if (tMaxX < tMaxY) { cellX += stepX; tMaxX += tDeltaX; }
+        else               { cellY += stepY; tMaxY += tDeltaY; }
+    }
+    return best;
+}
+
+/* Cast creature i's rays, spread evenly edge to edge across its vision
+   cone (one ray points straight ahead), into SENSE_RAY_INPUTS inputs each:
+   distance / vision and hit type. Rays past c->rays read (1, 0). */
+static void RayInputs(const Simulation *s, int i, float *inputs) {
+    const Creature *c = &s->creatures[i];
+    int rays = c->rays;
+    for (int r = 0; r < SENSE_RAYS_MAX; r++) {
+        float dist = c->vision, type = 0.0f;
+        if (r < rays) {
+            float angle = rays > 1
+                ? c->facing - c->visionAngle + 2.0f * c->visionAngle * (float)r / (float)(rays - 1)
+                : c->facing;
+            dist = TraceRay(s, i, cosf(angle), sinf(angle), c->vision, &type);
+        }
+        inputs[r * SENSE_RAY_INPUTS + 0] = dist / c->vision;
+        inputs[r * SENSE_RAY_INPUTS + 1] = type;
+    }
+}
+
+/* Sense environment + evaluate NN for creature i.
+   With staggered sensing (K = senseCohorts > 1) only creatures whose id
+   falls in this tick's cohort re-query the grids; the rest keep their
+   cached targets and only the distance/angle to them is recomputed from
+   the creature's own new position and facing. A cached target that has
+   fallen out of vision range is dropped. With raycast sensors the rays
+   are only cast by the current cohort; the rest keep their last readings.
+   Reads the food and creature grids anywhere in the world (including
+   neighbouring strips); writes only creature i's own sensor and NN state. */
+static void SenseCreature(void *ctx, int strip, int i) {
+    (void)strip;
+    const StepCtx *step = (const StepCtx *)ctx;
+    Simulation    *s    = step->s;
+    Creature      *c    = &s->creatures[i];
+
+    s->nbr[i].age += step->dt;
+    bool query = !c->sensed || step->senseCohorts <= 1 ||
+                 c->id % step->senseCohorts == step->senseCohort;
+
+    float inputs[NN_INPUTS];
+    for (int ii = 0; ii < SENSE_INPUTS; ii++) inputs[ii] = 0.0f;
+
+    if (s->sensors == SENSORS_RAYS) {
+        if (query) {
+            RayInputs(s, i, inputs);
+            c->sensed = true;
+        } else {
+            for (int ii = 0; ii < SENSE_RAY_INPUTS_ALL; ii++) inputs[ii] = c->nnInputs[ii];
+        }
+    } else {
+        if (query) QuerySensors(s, i, c);
+
+        /* k nearest food, then k nearest creatures, against the cached positions */
+        float *crInputs = inputs + SENSE_FOOD_K * SENSE_TARGET_INPUTS;
+        TargetInputs(s, c, c->foodTargets, &c->foodTargetCount, SENSE_FOOD_K, inputs);
+        TargetInputs(s, c, c->crTargets,   &c->crTargetCount,   SENSE_CREATURE_K, crInputs);
+    }
+
+    /* ── Energy and bias ───────────────────────────────── */
+    inputs[SENSE_INPUTS]     = c->energy / c->maxEnergy;  /* energy_norm: [0,1] */
+    inputs[SENSE_INPUTS + 1] = 1.0f;                       /* bias */
+
+    /* Store inputs on creature for visualization */
+    for (int ii = 0; ii < NN_INPUTS; ii++) c->nnInputs[ii] = inputs[ii];
+
+    /* ── Evaluate neural network ───────────────────────── */
+    GenomeEvalNN(c->genome, inputs, NULL, c->nnOutputs);
+}
+
+/* Physics, energy and aging for creature i (uses nnOutputs set by SenseCreature).
+   A creature whose grid cell changed is queued for relinking; the grid itself
+   is shared between strips, so it is only written after the pass. */
+static void MoveCreature(void *ctx, int strip, int i) {
+    const StepCtx *step = (const StepCtx *)ctx;
+    Simulation    *s    = step->s;
+    Creature      *c    = &s->creatures[i];
+    CreatureUpdate(c, step->dt, s->world.width, s->world.height);
+    if (SpatialMoved(&s->crGrid, i)) {
+        s->crossed[s->domain.start[strip] + s_stripCrossed[strip]++] = i;
+    }
+}
+
+/* Radius query visitor: creature eats food item f and ends the query */
+typedef struct {
+    Simulation *s;
+    Creature   *c;
+    int         strip;
+} EatQuery;
+
+static bool EatItem(void *ctx, int f, float dx, float dy, float dSq) {
+    (void)dx; (void)dy; (void)dSq;
+    EatQuery   *q = (EatQuery *)ctx;
+    Simulation *s = q->s;
+    Creature   *c = q->c;
+    WorldFoodGridUnlink(&s->world, f);
+    s->world.food[f].eaten = true;
+    float diet = s->world.food[f].kind == FOOD_MEAT ? c->carnivory : 1.0f - c->carnivory;
+    c->energy += s->world.food[f].nutrition * diet;
+    if (c->energy > c->maxEnergy) c->energy = c->maxEnergy;
+    s->eatenFood[s->domain.start[q->strip] + s_stripEaten[q->strip]++] = f;
+    return true;
+}
+
+/* Eat at most one food item within reach of creature i, gaining
+   (1 − carnivory) of a plant's nutrition or carnivory of meat's.
+   eatRadius (max ~17 px) << GRID_CELL_SIZE (200 px), so the query reads
+   and writes only cells within one row of the creature, which
+   DomainForEachColored keeps disjoint between concurrently running strips. */
+static void EatFood(void *ctx, int strip, int i) {
+    Simulation *s = ((StepCtx *)ctx)->s;
+    Creature   *c = &s->creatures[i];
+    if (!c->alive) return;  /* killed in the contact phase */
+
+    EatQuery q = { s, c, strip };
+    SpatialQueryRadius(&s->world.foodGrid, c->position, c->size + FOOD_SIZE, NULL, EatItem, &q);
+}
+
+
+/* ── Creature contacts and predation ─────────────────────── */
+
+/* Ready to breed: NN output[2] above threshold, enough energy, no cooldown */
+static inline bool MateReady(const Creature *c) {
+    return c->alive && c->reproductionCooldown <= 0.0f &&
+           c->nnOutputs[2] > REPRODUCE_NN_THRESHOLD && c->energy >= REPRODUCE_MIN_ENERGY;
+}
+
+typedef struct {
+    const Simulation *s;
+    const Creature   *c;
+    bool              hunts;      /* c may pick a prey this tick */
+    int               prey;       /* best prey so far, -1 = none */
+    float             preyDistSq;
+    bool              courts;     /* c may pick a mate this tick */
+    float             mateReachSq;
+    int               mate;       /* nearest ready mate so far, -1 = none */
+    float             mateDistSq;
+    bool              separates;  /* accumulate c's separation push */
+    float             pushX, pushY;
+    int               contacts;
+} ContactQuery;
+
+/* Keep candidate j as c's mate if it is ready, within mate reach and
+   nearer than the best so far; if its body touches c's, count it, add c's
+   share of pushing the two apart, and keep it as prey if c outsizes it
+   enough and it is the nearest such. Ties go to the lower slot, so no
+   choice depends on list order. */
+static void ConsiderContact(void *ctx, int j) {
+    ContactQuery   *q = (ContactQuery *)ctx;
+    const Creature *o = &q->s->creatures[j];
+    float dx    = TORUS_DELTA(o->position.x - q->c->position.x, q->s->world.width);
+    float dy    = TORUS_DELTA(o->position.y - q->c->position.y, q->s->world.height);
+    float reach = q->c->size + o->size;
+    float dSq   = dx*dx + dy*dy;
+
+    if (q->courts && dSq < q->mateReachSq && MateReady(o) &&
+        (dSq < q->mateDistSq || (dSq == q->mateDistSq && j < q->mate))) {
+        q->mate       = j;
+        q->mateDistSq = dSq;
+    }
+    if (dSq >= reach * reach) return;
+
+    q->contacts++;
+    /* c moves away by its share of STIFFNESS × overlap, the lighter body
+       taking more; coincident centres have no direction and are left to
+       drift apart */
+    if (q->separates && dSq > 0.0f) {
+        float d     = sqrtf(dSq);
+        float mc    = q->c->size * q->c->size;
+        float mo    = o->size * o->size;
+        float scale = SEPARATION_STIFFNESS * (reach - d) / d * (mo / (mc + mo));
+        q->pushX -= dx * scale;
+        q->pushY -= dy * scale;
+    }
+    if (!q->hunts || q->c->size < o->size * PREDATION_SIZE_RATIO) return;
+    if (dSq < q->preyDistSq || (dSq == q->preyDistSq && j < q->prey)) {
+        q->prey       = j;
+        q->preyDistSq = dSq;
+    }
+}
+
+/* Broadphase contact pass for creature i: bodies touching it, found through
+   its Verlet list (contact reach ≤ 2 × max size, well inside vision + skin),
+   so the cost follows local density rather than population². The same walk
+   picks a ready creature's nearest ready mate (mate reach is capped at
+   vision, which the list covers) and sums its separation push. Writes go
+   only to slot i of preyOf, mateOf and pushX/pushY. */
+static void ContactCreature(void *ctx, int strip, int i) {
+    const StepCtx *step = (const StepCtx *)ctx;
+    Simulation    *s    = step->s;
+    Creature      *c    = &s->creatures[i];
+
+    EnsureNbrList(s, i);
+    float mateReach = c->vision < MATE_RADIUS ? c->vision : MATE_RADIUS;
+    ContactQuery q = {
+        s, c, c->carnivory >= PREDATION_MIN_CARNIVORY && c->attackCooldown <= 0.0f,
+        -1, FLT_MAX,
+        step->sexual && MateReady(c), mateReach * mateReach, -1, FLT_MAX,
+        step->separate, 0.0f, 0.0f, 0
+    };
+    VisitNeighbours(s, i, ConsiderContact, &q);
+    s->preyOf[i] = q.prey;
+    s->mateOf[i] = q.mate;
+    s->pushX[i]  = q.pushX;
+    s->pushY[i]  = q.pushY;
+    s_stripContacts[strip] += q.contacts;
+}
+
+/* Turn this tick's prey choices into kills, independent of strip and thread
+   scheduling: each prey goes to its largest attacker (lower slot on ties),
+   then kills apply in prey slot order, skipping any whose attacker or prey
+   already died earlier in the pass. */
+static void ResolvePredation(Simulation *s) {
+    for (int i = 0; i < s->creatureCount; i++) {
+        if (!s->creatures[i].alive) continue;
+        int p = s->preyOf[i];
+        if (p < 0) continue;
+        int cur = s->claimedBy[p];
+        if (cur < 0 || s->creatures[i].size > s->creatures[cur].size) s->claimedBy[p] = i;
+    }
+
+    for (int p = 0; p < s->creatureCount; p++) {
+        int a = s->claimedBy[p];
+        if (a < 0) continue;
+        s->claimedBy[p] = -1;
+
+        Creature *prey   = &s->creatures[p];
+        Creature *hunter = &s->creatures[a];
+        if (!prey->alive || !hunter->alive) continue;
+
+        hunter->energy += prey->maxEnergy * PREDATION_YIELD * hunter->carnivory;
+        if (hunter->energy > hunter->maxEnergy) hunter->energy = hunter->maxEnergy;
+        hunter->attackCooldown = PREDATION_COOLDOWN;
+
+        prey->alive  = false;
+        prey->energy = 0.0f;
+        RetireCreature(s, p);
+        s->totalKills++;
+    }
+}
+
+/* Move each living creature by the push the contact pass found for it and
+   relink the ones that changed cell. Every push was computed from the same
+   positions before any is applied (Jacobi), so the result depends on neither
+   slot order nor thread count. The largest push is added to pushTravel:
+   neighbour lists budget for it like for movement. */
+static void ApplySeparation(Simulation *s) {
+    float fw    = (float)s->world.width;
+    float fh    = (float)s->world.height;
+    float maxSq = 0.0f;
+    for (int i = 0; i < s->creatureCount; i++) {
+        Creature *c = &s->creatures[i];
+        if (!c->alive) continue;
+        float px = s->pushX[i], py = s->pushY[i];
+        if (px == 0.0f && py == 0.0f) continue;
 
-/* ── Toroidal distance helper ────────────────────────────────── */
-#define TORUS_DELTA(val, dim) \
-    ((val) >  (dim)*0.5f ? (val)-(dim) : (val) < -(dim)*0.5f ? (val)+(dim) : (val))
+        c->position.x = fmodf(c->position.x + px + fw, fw);
+        c->position.y = fmodf(c->position.y + py + fh, fh);
+        if (px*px + py*py > maxSq) maxSq = px*px + py*py;
+        if (SpatialMoved(&s->crGrid, i)) SpatialRelink(&s->crGrid, i);
+    }
+    s->pushTravel += sqrtf(maxSq);
+}
+
+/* ── Disease ─────────────────────────────────────────────── */
+
+/* True with probability p, from the raylib RNG (15-bit resolution) */
+static inline bool RandChance(float p) {
+    return GetRandomValue(0, 0x7FFF) < (int)(p * 0x8000);
+}
 
-/* Grid cell index for a position known to be in [0, WORLD_W/H). */
-static inline int CrCell(float x, float y) {
-    int col = (int)(x / GRID_CELL_SIZE) % GRID_COLS;
-    int row = (int)(y / GRID_CELL_SIZE) % GRID_ROWS;
-    return row * GRID_COLS + col;
+static inline bool Susceptible(const Simulation *s, const Creature *c) {
+    return c->alive && c->sickSlot < 0 && s->world.tick >= c->immuneUntil;
 }
 
-/* Wrap a raw column/row index (may be negative or >= limit). */
-static inline int WrapCol(int c) { return ((c % GRID_COLS) + GRID_COLS) % GRID_COLS; }
-static inline int WrapRow(int r) { return ((r % GRID_ROWS) + GRID_ROWS) % GRID_ROWS; }
+static void Infect(Simulation *s, int i) {
+    Creature *c  = &s->creatures[i];
+    c->sickSlot  = s->sickCount;
+    c->sickUntil = s->world.tick + DISEASE_SICK_TICKS;
+    s->sick[s->sickCount++] = i;
+    s->totalInfections++;
+}
+
+/* Radius query visitor: expose creature j to one sick neighbour */
+typedef struct {
+    Simulation *s;
+    float       p;
+} Exposure;
+
+static bool Expose(void *ctx, int j, float dx, float dy, float dSq) {
+    (void)dx; (void)dy; (void)dSq;
+    Exposure *e = (Exposure *)ctx;
+    if (Susceptible(e->s, &e->s->creatures[j]) && RandChance(e->p)) Infect(e->s, j);
+    return false;
+}
+
+/* One epidemic step, serial: every sick creature recovers if its time is up,
+   otherwise exposes the susceptible creatures within DISEASE_RADIUS, found in
+   the (at most 2×2) creature grid cells the radius overlaps. Only the sick
+   are visited, so the cost follows the outbreak, not the population.
+   Creatures infected this tick start spreading next tick. */
+static void SpreadDisease(Simulation *s, float dt) {
+    Exposure e = { s, DISEASE_TRANSMIT * dt };
+
+    /* Backwards, so a cure's swap only moves in an entry already visited
+       or one infected this tick */
+    for (int k = s->sickCount - 1; k >= 0; k--) {
+        int       i = s->sick[k];
+        Creature *c = &s->creatures[i];
+        if (s->world.tick >= c->sickUntil) {
+            Cure(s, i);
+            c->immuneUntil = s->world.tick + DISEASE_IMMUNE_TICKS;
+            continue;
+        }
+        SpatialQueryRadius(&s->crGrid, c->position, DISEASE_RADIUS, NULL, Expose, &e);
+    }
+}
+
+/* ── Drawing ─────────────────────────────────────────────── */
+
+/* Rect query visitor for SimulationDraw */
+typedef struct {
+    const Simulation *s;
+    Rectangle         view;
+    CreatureLOD       lod;
+    float             pointSize;
+} DrawQuery;
+
+static void DrawCulled(void *ctx, int i) {
+    const DrawQuery *q = (const DrawQuery *)ctx;
+    const Creature  *c = &q->s->creatures[i];
+    if (!c->alive) return;
+
+    float r = (q->lod == CREATURE_LOD_FULL) ? fmaxf(c->vision, c->size * 1.8f) : c->size * 1.8f;
+    if (c->position.x + r < q->view.x || c->position.x - r > q->view.x + q->view.width ||
+        c->position.y + r < q->view.y || c->position.y - r > q->view.y + q->view.height) return;
+
+    if (q->lod == CREATURE_LOD_POINT) CreatureDrawPoint(c, q->pointSize);
+    else                              CreatureDraw(c, q->lod);
+}
 
 /* ── Public API ──────────────────────────────────────────────── */
 
-void SimulationInit(Simulation *s) {
-    assert(s != NULL);
+void SimulationInit(Simulation *s, const SimParams *params) {
+    assert(s != NULL && params != NULL);
+    memset(s, 0, sizeof(*s));
 
-    WorldInit(&s->world);
+    WorldInit(&s->world, params->worldWidth, params->worldHeight, params->maxFood, params->fertility,
+              (CellTableMode)params->grid);
+    DomainInit(&s->domain, s->world.gridRows);
+    SpeciesInit(&s->species);
+    GenomePoolInit(&s->genomes);
 
+    s->maxCreatures  = params->maxCreatures;
+    s->sensors       = (SensorMode)params->sensors;
     s->creatureCount = 0;
     s->nextId        = 0;
     s->totalDeaths   = 0;
     s->totalBirths   = 0;
     s->aliveCount    = 0;
 
-    /* Zero out history ring buffer */
+    /* Creature grid cells are sized once from the world; the pool grows on demand */
+    SpatialInit(&s->crGrid, s->world.width, s->world.height, s->maxCreatures,
+                (CellTableMode)params->grid);
+    s->birthLog = malloc(NBR_BIRTH_LOG * sizeof(*s->birthLog));
+    if (!s->birthLog) TraceLog(LOG_FATAL, "SIM: out of memory allocating creature grid");
+    int initial = INITIAL_CREATURES < s->maxCreatures ? INITIAL_CREATURES : s->maxCreatures;
+    GrowCreaturePool(s, initial);
+
+    /* Zero out history tiers */
     memset(&s->history, 0, sizeof(s->history));
 
     /* Spawn initial creatures at random positions with random genomes */
-    for (int i = 0; i < INITIAL_CREATURES && i < MAX_CREATURES; i++) {
+    for (int i = 0; i < initial; i++) {
         Vector2 pos = {
             (float)GetRandomValue((int)CREATURE_SIZE, s->world.width  - (int)CREATURE_SIZE),
             (float)GetRandomValue((int)CREATURE_SIZE, s->world.height - (int)CREATURE_SIZE)
         };
-        Genome genome;
-        GenomeRandom(&genome);
-        CreatureInit(&s->creatures[i], s->nextId++, pos, &genome);
+        SpawnCreature(s, i, pos, GenomePoolAdd(&s->genomes, GenomeRandom()), NULL);
         s->creatureCount++;
         s->aliveCount++;
     }
 }
 
+void SimulationFree(Simulation *s) {
+    assert(s != NULL);
+    WorldFree(&s->world);
+    DomainFree(&s->domain);
+    SpeciesFree(&s->species);
+    GenomePoolFree(&s->genomes);
+    free(s->creatures);
+    free(s->freeSlots);
+    free(s->eatenFood);
+    SpatialFree(&s->crGrid);
+    free(s->crossed);
+    free(s->preyOf);
+    free(s->claimedBy);
+    free(s->mateOf);
+    free(s->pushX);
+    free(s->pushY);
+    free(s->sick);
+    for (int i = 0; i < s->creatureCap; i++) free(s->nbr[i].idx);
+    free(s->nbr);
+    free(s->birthLog);
+    memset(s, 0, sizeof(*s));
+}
+
 void SimulationUpdate(Simulation *s, float dt, const SimSettings *settings) {
     assert(s != NULL);
     assert(settings != NULL);
 
-    /* Apply runtime food settings */
-    s->world.foodTarget    = settings->foodTarget;
-    s->world.foodSpawnRate = settings->foodSpawnRate;
-
-    WorldUpdate(&s->world, dt);
-
-    /* ── Build creature spatial grid ──────────────────────── */
-    memset(s_crGridHead, -1, sizeof(s_crGridHead));
-    for (int i = 0; i < s->creatureCount; i++) {
-        if (!s->creatures[i].alive) continue;
-        int cell = CrCell(s->creatures[i].position.x, s->creatures[i].position.y);
-        s_crGridNext[i]    = s_crGridHead[cell];
-        s_crGridHead[cell] = i;
+    /* Apply runtime food settings, scaled by the season when seasons are on */
+    float rateMult = 1.0f, targetMult = 1.0f;
+    if (settings->seasons) {
+        const Season *season = SeasonAt(s->world.tick);
+        rateMult   = season->foodRateMult;
+        targetMult = season->foodTargetMult;
     }
+    s->world.foodTarget    = (int)(settings->foodTarget * targetMult);
+    s->world.foodSpawnRate = settings->foodSpawnRate * rateMult;
 
-    /* ── Sense environment + evaluate NN for each alive creature ── */
-    for (int i = 0; i < s->creatureCount; i++) {
-        Creature *c = &s->creatures[i];
-        if (!c->alive) continue;
-
-        float inputs[NN_INPUTS];
-
-        /* Precompute vision radius squared and cell range once */
-        float visionSq = c->vision * c->vision;
-        int minCol = (int)((c->position.x - c->vision) / GRID_CELL_SIZE);
-        int maxCol = (int)((c->position.x + c->vision) / GRID_CELL_SIZE);
-        int minRow = (int)((c->position.y - c->vision) / GRID_CELL_SIZE);
-        int maxRow = (int)((c->position.y + c->vision) / GRID_CELL_SIZE);
-
-        /* ── Food sensor ───────────────────────────────────── */
-        int   bestFoodIdx    = -1;
-        float bestFoodDistSq = visionSq;  /* only within vision radius */
-
-        for (int gr = minRow; gr <= maxRow; gr++) {
-            int row = WrapRow(gr);
-            for (int gc = minCol; gc <= maxCol; gc++) {
-                int col  = WrapCol(gc);
-                int cell = row * GRID_COLS + col;
-                for (int f = s->world.foodGridHead[cell]; f != -1;
-                         f = s->world.foodGridNext[f]) {
-                    float dx = TORUS_DELTA(s->world.plants[f].position.x - c->position.x,
-                                          s->world.width);
-                    float dy = TORUS_DELTA(s->world.plants[f].position.y - c->position.y,
-                                          s->world.height);
-                    float dSq = dx*dx + dy*dy;
-                    if (dSq >= bestFoodDistSq) continue;
-                    /* Angular check: must be within creature's FOV cone */
-                    float angle = atan2f(dy, dx) - c->facing;
-                    while (angle >  PI) angle -= 2.0f * PI;
-                    while (angle < -PI) angle += 2.0f * PI;
-                    if (fabsf(angle) > c->visionAngle) continue;
-                    bestFoodDistSq = dSq;
-                    bestFoodIdx    = f;
-                }
-            }
-        }
-
-        if (bestFoodIdx >= 0) {
-            inputs[0] = sqrtf(bestFoodDistSq) / c->vision;
-            float dx = TORUS_DELTA(s->world.plants[bestFoodIdx].position.x - c->position.x,
-                                   s->world.width);
-            float dy = TORUS_DELTA(s->world.plants[bestFoodIdx].position.y - c->position.y,
-                                   s->world.height);
-            float relAngle = atan2f(dy, dx) - c->facing;
-            inputs[1] = sinf(relAngle);
-            inputs[2] = cosf(relAngle);
-        } else {
-            inputs[0] = 1.0f;
-            inputs[1] = 0.0f;
-            inputs[2] = 0.0f;
-        }
-
-        /* ── Nearest other creature sensor ─────────────────── */
-        int   bestCIdx    = -1;
-        float bestCDistSq = visionSq;
-
-        for (int gr = minRow; gr <= maxRow; gr++) {
-            int row = WrapRow(gr);
-            for (int gc = minCol; gc <= maxCol; gc++) {
-                int col  = WrapCol(gc);
-                int cell = row * GRID_COLS + col;
-                for (int j = s_crGridHead[cell]; j != -1; j = s_crGridNext[j]) {
-                    if (j == i) continue;
-                    float dx = TORUS_DELTA(s->creatures[j].position.x - c->position.x,
-                                          s->world.width);
-                    float dy = TORUS_DELTA(s->creatures[j].position.y - c->position.y,
-                                          s->world.height);
-                    float dSq = dx*dx + dy*dy;
-                    if (dSq >= bestCDistSq) continue;
-                    float angle = atan2f(dy, dx) - c->facing;
-                    while (angle >  PI) angle -= 2.0f * PI;
-                    while (angle < -PI) angle += 2.0f * PI;
-                    if (fabsf(angle) > c->visionAngle) continue;
-                    bestCDistSq = dSq;
-                    bestCIdx    = j;
-                }
-            }
-        }
-
-        if (bestCIdx >= 0) {
-            inputs[3] = sqrtf(bestCDistSq) / c->vision;
-            float dx = TORUS_DELTA(s->creatures[bestCIdx].position.x - c->position.x,
-                                   s->world.width);
-            float dy = TORUS_DELTA(s->creatures[bestCIdx].position.y - c->position.y,
-                                   s->world.height);
-            float relAngle = atan2f(dy, dx) - c->facing;
-            inputs[4] = sinf(relAngle);
-        } else {
-            inputs[3] = 1.0f;
-            inputs[4] = 0.0f;
-        }
-
-        /* ── Energy and bias ───────────────────────────────── */
-        inputs[5] = c->energy / c->maxEnergy;  /* energy_norm: [0,1] */
-        inputs[6] = 1.0f;                       /* bias */
-
-        /* Store inputs on creature for visualization */
-        for (int ii = 0; ii < NN_INPUTS; ii++) c->nnInputs[ii] = inputs[ii];
+    WorldUpdate(&s->world, dt);
 
-        /* ── Evaluate neural network ───────────────────────── */
-        GenomeEvalNN(&c->genome, inputs, c->hiddenOut, c->nnOutputs);
-    }
+    /* ── Sense environment + evaluate NN, one worker per strip ── */
+    DomainAssign(&s->domain, s->creatures, s->creatureCount);
+    int cohorts = settings->senseCohorts > 1 ? settings->senseCohorts : 1;
+    StepCtx step = { s, dt, cohorts, s->world.tick % cohorts, settings->sexual, settings->collisions };
+    DomainForEach(&s->domain, SenseCreature, &step);
 
     /* Update creature physics, energy, aging (uses nnOutputs set above) */
-    for (int i = 0; i < s->creatureCount; i++) {
-        CreatureUpdate(&s->creatures[i], dt, s->world.width, s->world.height);
+    memset(s_stripCrossed, 0, sizeof(s_stripCrossed));
+    DomainForEach(&s->domain, MoveCreature, &step);
+
+    /* Move creatures that crossed a cell boundary to their new cell —
+       O(crossings) grid writes instead of a full rebuild */
+    for (int k = 0; k < s->domain.stripCount; k++) {
+        for (int e = 0; e < s_stripCrossed[k]; e++) {
+            SpatialRelink(&s->crGrid, s->crossed[s->domain.start[k] + e]);
+        }
     }
 
-    /* Detect deaths (before eating/reproduction so aliveCount is accurate) */
+    /* Detect deaths (before eating/reproduction so aliveCount is accurate);
+       each body is left behind as meat */
     for (int i = 0; i < s->creatureCount; i++) {
-        Creature *c = &s->creatures[i];
+        const Creature *c = &s->creatures[i];
         if (!c->alive && c->age >= 0.0f) {
-            s->totalDeaths++;
-            s->aliveCount--;
-            c->age = -1.0f;  /* sentinel: already counted */
+            WorldDropMeat(&s->world, c->position, c->maxEnergy * MEAT_YIELD);
+            RetireCreature(s, i);
         }
     }
 
-    /* Check eating: use food grid for fast proximity query.
-       eatRadius (max ~17 px) << GRID_CELL_SIZE (200 px) so a 3×3 cell
-       neighbourhood is always sufficient — no food can be missed. */
-    for (int i = 0; i < s->creatureCount; i++) {
-        Creature *c = &s->creatures[i];
-        if (!c->alive) continue;
-
-        float eatRadius = c->size + FOOD_SIZE;
-        float eatRadSq  = eatRadius * eatRadius;
-        int   crCol     = (int)(c->position.x / GRID_CELL_SIZE) % GRID_COLS;
-        int   crRow     = (int)(c->position.y / GRID_CELL_SIZE) % GRID_ROWS;
-
-        bool ate = false;
-        for (int gr = crRow - 1; gr <= crRow + 1 && !ate; gr++) {
-            int row = WrapRow(gr);
-            for (int gc = crCol - 1; gc <= crCol + 1 && !ate; gc++) {
-                int col  = WrapCol(gc);
-                int cell = row * GRID_COLS + col;
-                int f    = s->world.foodGridHead[cell];
-                while (f != -1 && !ate) {
-                    int nextF = s->world.foodGridNext[f];  /* save before removal */
-                    float dx = TORUS_DELTA(s->world.plants[f].position.x - c->position.x,
-                                          s->world.width);
-                    float dy = TORUS_DELTA(s->world.plants[f].position.y - c->position.y,
-                                          s->world.height);
-                    if (dx*dx + dy*dy < eatRadSq) {
-                        float nutrition = s->world.plants[f].nutrition;
-                        WorldFoodGridRemove(&s->world, f);
-                        s->world.plants[f].eaten = true;
-                        c->energy += nutrition;
-                        if (c->energy > c->maxEnergy) c->energy = c->maxEnergy;
-                        ate = true;
-                    }
-                    f = nextF;
-                }
-            }
+    /* Re-assign strips after movement (hand-off of creatures that crossed
+       a strip boundary) for the contact and eating passes */
+    DomainAssign(&s->domain, s->creatures, s->creatureCount);
+
+    /* Contacts: parallel prey, mate and push choice, serial resolution */
+    double contactStart = TimingSeconds();
+    memset(s_stripContacts, 0, sizeof(s_stripContacts));
+    DomainForEach(&s->domain, ContactCreature, &step);
+    s->contacts = 0;
+    for (int k = 0; k < s->domain.stripCount; k++) s->contacts += s_stripContacts[k];
+    ResolvePredation(s);
+    if (settings->collisions) ApplySeparation(s);
+    s->contactTime = (float)(TimingSeconds() - contactStart);
+
+    /* Disease: spontaneous patient zeros, then spread from the sick */
+    if (settings->outbreaks && RandChance(DISEASE_OUTBREAK_RATE * dt)) SimulationInfect(s, 1);
+    SpreadDisease(s, dt);
+
+    /* Check eating in two colors so adjacent strips never touch the same
+       food cells at the same time */
+    memset(s_stripEaten, 0, sizeof(s_stripEaten));
+    DomainForEachColored(&s->domain, EatFood, &step);
+    for (int k = 0; k < s->domain.stripCount; k++) {
+        for (int e = 0; e < s_stripEaten[k]; e++) {
+            WorldFoodRelease(&s->world, s->eatenFood[s->domain.start[k] + e]);
         }
     }
 
-    /* Reproduce: NN output[2] above threshold + enough energy + no cooldown */
+    /* Reproduce: sexually, each pair whose mate choices were mutual breeds
+       once (from its lower slot — the other is then on cooldown); a ready
+       creature that has found no mate for MATE_PATIENCE, or every ready
+       creature when sexual reproduction is off, clones itself. A pair whose
+       member died or spent its readiness since the contact pass waits. */
     int currentCount = s->creatureCount;  /* snapshot so new births don't trigger again */
     for (int i = 0; i < currentCount; i++) {
         Creature *c = &s->creatures[i];
-        if (!c->alive) continue;
-        if (c->reproductionCooldown > 0.0f) continue;
-        if (c->nnOutputs[2] <= REPRODUCE_NN_THRESHOLD) continue;
-        if (c->energy < REPRODUCE_MIN_ENERGY) continue;
-        if (s->aliveCount >= MAX_CREATURES) break;
-
-        /* Find a free slot: dead slot first, then extend array */
-        int slot = -1;
-        for (int j = 0; j < s->creatureCount; j++) {
-            if (!s->creatures[j].alive && s->creatures[j].age < 0.0f) {
-                slot = j;
-                break;
+        if (!MateReady(c)) continue;
+        if (s->aliveCount >= s->maxCreatures) break;
+
+        int mate = i;
+        if (settings->sexual) {
+            int m = s->mateOf[i];
+            if (m >= 0 && s->mateOf[m] == i && MateReady(&s->creatures[m])) {
+                mate = m;
+            } else {
+                c->courting += dt;
+                if (c->courting < MATE_PATIENCE) continue;
             }
         }
-        if (slot < 0 && s->creatureCount < MAX_CREATURES) {
-            slot = s->creatureCount++;
-        }
-        if (slot < 0) continue;
-
-        /* Spawn child near parent */
-        float ox = (float)GetRandomValue(-20, 20);
-        float oy = (float)GetRandomValue(-20, 20);
-        Vector2 childPos = {
-            Clamp(c->position.x + ox, c->size, (float)s->world.width  - c->size),
-            Clamp(c->position.y + oy, c->size, (float)s->world.height - c->size)
-        };
 
-        /* Asexual reproduction: self-crossover with mutation, scaled by mutRateMult */
-        Genome childGenome;
-        float mutRate = c->genome.mutationRate * settings->mutRateMult;
-        GenomeCrossover(&c->genome, &c->genome, &childGenome, mutRate);
-        CreatureInit(&s->creatures[slot], s->nextId++, childPos, &childGenome);
-
-        /* Transfer energy */
-        s->creatures[slot].energy = c->energy * REPRODUCE_ENERGY_COST;
-        c->energy *= (1.0f - REPRODUCE_ENERGY_COST);
-        c->reproductionCooldown = REPRODUCE_COOLDOWN;
-        s->totalBirths++;
-        s->aliveCount++;
+        /* Find a free slot; growing the pool may move the array */
+        int slot = AllocCreatureSlot(s);
+        if (slot < 0) break;
+        Breed(s, slot, i, mate, settings->mutRateMult);
     }
 
     /* Population floor: respawn random creatures if alive count drops below slider value */
-    while (s->aliveCount < settings->minPopulation && s->creatureCount < MAX_CREATURES) {
-        int slot = -1;
-        for (int j = 0; j < s->creatureCount; j++) {
-            if (!s->creatures[j].alive && s->creatures[j].age < 0.0f) { slot = j; break; }
-        }
-        if (slot < 0) slot = s->creatureCount++;
+    while (s->aliveCount < settings->minPopulation) {
+        int slot = AllocCreatureSlot(s);
+        if (slot < 0) break;
 
         Vector2 pos = {
             (float)GetRandomValue((int)CREATURE_SIZE, s->world.width  - (int)CREATURE_SIZE),
             (float)GetRandomValue((int)CREATURE_SIZE, s->world.height - (int)CREATURE_SIZE)
         };
-        Genome genome;
-        GenomeRandom(&genome);
-        CreatureInit(&s->creatures[slot], s->nextId++, pos, &genome);
+        SpawnCreature(s, slot, pos, GenomePoolAdd(&s->genomes, GenomeRandom()), NULL);
         s->aliveCount++;
     }
 
     /* Record history sample every HISTORY_SAMPLE_TICKS ticks */
     if (s->world.tick % HISTORY_SAMPLE_TICKS == 0) {
-        float sumSpeed = 0.0f, sumMeta = 0.0f;
-        int   counted  = 0;
-
-        for (int i = 0; i < s->creatureCount; i++) {
-            if (!s->creatures[i].alive) continue;
-            sumSpeed += s->creatures[i].speed;
-            sumMeta  += s->creatures[i].metabolism;
-            counted++;
+        float sample[HIST_SERIES_COUNT];
+        sample[HIST_POPULATION] = (float)s->aliveCount;
+        sample[HIST_FOOD]       = (float)s->world.foodCount;
+        sample[HIST_SPECIES]    = (float)s->species.alive;
+        for (int t = 0; t < TRAIT_COUNT; t++) {
+            sample[HIST_TRAIT_MEAN + t] = PopStatsMean(&s->stats, (Trait)t);
         }
-
-        float avgSpeed = (counted > 0) ? sumSpeed / counted : 0.0f;
-        float avgMeta  = (counted > 0) ? sumMeta  / counted : 0.0f;
-
-        HistoryRecord(&s->history, s->aliveCount, s->world.foodCount, avgSpeed, avgMeta);
+        HistoryRecord(&s->history, sample);
     }
 }
 
-void SimulationDraw(const Simulation *s) {
+void SimulationDraw(const Simulation *s, const WorldLayers *layers, Rectangle view, float zoom) {
     assert(s != NULL);
 
-    WorldDraw(&s->world);
+    WorldDraw(&s->world, layers, view, zoom);
 
-    for (int i = 0; i < s->creatureCount; i++) {
-        CreatureDraw(&s->creatures[i]);
-    }
+    CreatureLOD lod = zoom >= LOD_FOV_ZOOM  ? CREATURE_LOD_FULL
+                    : zoom >= LOD_BODY_ZOOM ? CREATURE_LOD_BODY
+                    :                         CREATURE_LOD_POINT;
+
+    /* Cull through the creature grid: only creatures within the largest
+       drawn extent (FOV cone at full detail, body otherwise) of the view */
+    float     reach = (lod == CREATURE_LOD_FULL) ? s->maxVision : CREATURE_DRAW_REACH;
+    Rectangle near  = { view.x - reach, view.y - reach, view.width + 2.0f * reach, view.height + 2.0f * reach };
+    DrawQuery q     = { s, view, lod, 1.5f / zoom };  /* points ~1.5 screen px */
+
+    /* Points are emitted as one batch of quads; other LODs draw per creature */
+    if (lod == CREATURE_LOD_POINT) rlBegin(RL_QUADS);
+    SpatialQueryRect(&s->crGrid, near, DrawCulled, &q);
+    if (lod == CREATURE_LOD_POINT) rlEnd();
 }
 
 int SimulationAliveCount(const Simulation *s) {
     assert(s != NULL);
     return s->aliveCount;  /* O(1) — maintained incrementally */
 }
+
+int SimulationPick(const Simulation *s, Vector2 pos, float radius) {
+    assert(s != NULL);
+    SpatialNearest h = { .k = 1 };
+    SpatialQueryNearest(&s->crGrid, pos, radius, NULL, &h);
+    return h.n > 0 ? h.idx[0] : -1;
+}
+
+void SimulationInfect(Simulation *s, int count) {
+    assert(s != NULL);
+    if (s->aliveCount == 0) return;
+    for (int n = 0; n < count; n++) {
+        /* A few random probes per patient — the pool is mostly living creatures */
+        for (int tries = 0; tries < 16; tries++) {
+            int i = GetRandomValue(0, s->creatureCount - 1);
+            if (!Susceptible(s, &s->creatures[i])) continue;
+            Infect(s, i);
+            break;
+        }
+    }
+}
@@ -0,0 +1,223 @@
+#include "spatial.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ── Internal helpers ────────────────────────────────────────── */
+
+/* Cell range reached by a radius around pos, clamped to one lap of the
+   torus so no cell comes up twice */
+static void RadiusCells(const SpatialGrid *g, Vector2 pos, float radius,
+                        int *minCol, int *minRow, int *maxCol, int *maxRow) {
+    *minCol = (int)floorf((pos.x - radius) / GRID_CELL_SIZE);
+    *maxCol = (int)floorf((pos.x + radius) / GRID_CELL_SIZE);
+    *minRow = (int)floorf((pos.y - radius) / GRID_CELL_SIZE);
+    *maxRow = (int)floorf((pos.y + radius) / GRID_CELL_SIZE);
+    if (*maxCol - *minCol >= g->cols) *maxCol = *minCol + g->cols - 1;
+    if (*maxRow - *minRow >= g->rows) *maxRow = *minRow + g->rows - 1;
+}
+
+/* Offer every item of one cell to the k-nearest heap */
+static void NearestInCell(const SpatialGrid *g, Vector2 pos, int cell, float radiusSq,
+                          const SpatialCone *cone, SpatialNearest *h) {
+    for (int i = SpatialHead(g, cell); i != -1; i = g->next[i]) {
+        Vector2 p   = SpatialPos(g, i);
+        float   dx  = TORUS_DELTA(p.x - pos.x, g->width);
+        float   dy  = TORUS_DELTA(p.y - pos.y, g->height);
+        float   dSq = dx*dx + dy*dy;
+        if (dSq >= SpatialNearestBound(h, radiusSq)) continue;
+        if (cone && !SpatialInCone(cone, dx, dy)) continue;
+        SpatialNearestPush(h, dSq, i);
+    }
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+void SpatialInit(SpatialGrid *g, int width, int height, int maxItems, CellTableMode mode) {
+    assert(g != NULL);
+    assert(width % GRID_CELL_SIZE == 0 && height % GRID_CELL_SIZE == 0);
+    assert((long long)(width / GRID_CELL_SIZE) * (height / GRID_CELL_SIZE) <= INT_MAX);
+    memset(g, 0, sizeof(*g));
+    g->cols   = width  / GRID_CELL_SIZE;
+    g->rows   = height / GRID_CELL_SIZE;
+    g->width  = (float)width;
+    g->height = (float)height;
+    CellTableInit(&g->heads, g->cols * g->rows, maxItems, mode);
+}
+
+void SpatialFree(SpatialGrid *g) {
+    assert(g != NULL);
+    CellTableFree(&g->heads);
+    free(g->next);
+    free(g->cell);
+    memset(g, 0, sizeof(*g));
+}
+
+void SpatialReserve(SpatialGrid *g, int cap) {
+    assert(g != NULL);
+    if (cap <= g->cap) return;
+
+    int *next = realloc(g->next, (size_t)cap * sizeof(*g->next));
+    int *cell = realloc(g->cell, (size_t)cap * sizeof(*g->cell));
+    if (next) g->next = next;
+    if (cell) g->cell = cell;
+    if (!next || !cell) TraceLog(LOG_FATAL, "SPATIAL: out of memory growing grid links to %d", cap);
+
+    memset(g->next + g->cap, -1, (size_t)(cap - g->cap) * sizeof(*g->next));
+    memset(g->cell + g->cap, -1, (size_t)(cap - g->cap) * sizeof(*g->cell));
+    g->cap = cap;
+}
+
+void SpatialBind(SpatialGrid *g, const Vector2 *first, size_t stride) {
+    assert(g != NULL && first != NULL);
+    g->pos       = (const char *)first;
+    g->posStride = stride;
+}
+
+void SpatialInsert(SpatialGrid *g, int item) {
+    assert(g != NULL && item >= 0 && item < g->cap);
+    int cell      = SpatialCellOf(g, SpatialPos(g, item));
+    g->cell[item] = cell;
+    g->next[item] = SpatialHead(g, cell);
+    CellTableSet(&g->heads, cell, item);
+}
+
+void SpatialUnlink(SpatialGrid *g, int item) {
+    assert(g != NULL && item >= 0 && item < g->cap);
+    int cell = g->cell[item];
+    int head = SpatialHead(g, cell);
+    if (head == item) {
+        CellTableSet(&g->heads, cell, g->next[item]);
+    } else {
+        int prev = head;
+        while (prev != -1 && g->next[prev] != item) prev = g->next[prev];
+        if (prev != -1) g->next[prev] = g->next[item];
+    }
+    g->next[item] = -1;
+}
+
+void SpatialRelink(SpatialGrid *g, int item) {
+    SpatialUnlink(g, item);
+    SpatialInsert(g, item);
+}
+
+void SpatialNearestPush(SpatialNearest *h, float dSq, int idx) {
+    int i;
+    if (h->n < h->k) {
+        /* Sift up from the new leaf */
+        i = h->n++;
+        while (i > 0 && h->dSq[(i - 1) / 2] < dSq) {
+            h->dSq[i] = h->dSq[(i - 1) / 2];
+            h->idx[i] = h->idx[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+    } else {
+        /* Replace the root and sift down */
+        i = 0;
+        for (;;) {
+            int child = 2 * i + 1;
+            if (child >= h->n) break;
+            if (child + 1 < h->n && h->dSq[child + 1] > h->dSq[child]) child++;
+            if (h->dSq[child] <= dSq) break;
+            h->dSq[i] = h->dSq[child];
+            h->idx[i] = h->idx[child];
+            i = child;
+        }
+    }
+    h->dSq[i] = dSq;
+    h->idx[i] = idx;
+}
+
+void SpatialNearestSort(SpatialNearest *h) {
+    /* k is tiny: insertion sort */
+    for (int i = 1; i < h->n; i++) {
+        float d = h->dSq[i];
+        int   x = h->idx[i];
+        int   j = i;
+        for (; j > 0 && h->dSq[j - 1] > d; j--) {
+            h->dSq[j] = h->dSq[j - 1];
+            h->idx[j] = h->idx[j - 1];
+        }
+        h->dSq[j] = d;
+        h->idx[j] = x;
+    }
+}
+
+bool SpatialQueryRadius(const SpatialGrid *g, Vector2 pos, float radius, const SpatialCone *cone,
+                        SpatialVisitFn fn, void *ctx) {
+    assert(g != NULL && fn != NULL);
+    float rSq = radius * radius;
+    int   minCol, minRow, maxCol, maxRow;
+    RadiusCells(g, pos, radius, &minCol, &minRow, &maxCol, &maxRow);
+
+    for (int gr = minRow; gr <= maxRow; gr++) {
+        for (int gc = minCol; gc <= maxCol; gc++) {
+            for (int i = SpatialHead(g, SpatialCellAt(g, gc, gr)); i != -1; i = g->next[i]) {
+                Vector2 p   = SpatialPos(g, i);
+                float   dx  = TORUS_DELTA(p.x - pos.x, g->width);
+                float   dy  = TORUS_DELTA(p.y - pos.y, g->height);
+                float   dSq = dx*dx + dy*dy;
+                if (dSq >= rSq) continue;
+                if (cone && !SpatialInCone(cone, dx, dy)) continue;
+                if (fn(ctx, i, dx, dy, dSq)) return true;
+            }
+        }
+    }
+    return false;
+}
+
+void SpatialQueryNearest(const SpatialGrid *g, Vector2 pos, float radius, const SpatialCone *cone,
+                         SpatialNearest *h) {
+    assert(g != NULL && h != NULL && h->k > 0 && h->k <= SPATIAL_NEAREST_MAX);
+    float radiusSq = radius * radius;
+    int   minCol, minRow, maxCol, maxRow;
+    RadiusCells(g, pos, radius, &minCol, &minRow, &maxCol, &maxRow);
+
+    int cx    = (int)floorf(pos.x / GRID_CELL_SIZE);
+    int cy    = (int)floorf(pos.y / GRID_CELL_SIZE);
+    int rings = cx - minCol;
+    if (maxCol - cx > rings) rings = maxCol - cx;
+    if (cy - minRow > rings) rings = cy - minRow;
+    if (maxRow - cy > rings) rings = maxRow - cy;
+
+    for (int r = 0; r <= rings; r++) {
+        for (int gr = cy - r; gr <= cy + r; gr++) {
+            if (gr < minRow || gr > maxRow) continue;
+            /* Full row on the ring's top/bottom edge, else its two sides */
+            int step = (gr == cy - r || gr == cy + r) ? 1 : 2 * r;
+            for (int gc = cx - r; gc <= cx + r; gc += step) {
+                if (gc < minCol || gc > maxCol) continue;
+                NearestInCell(g, pos, SpatialCellAt(g, gc, gr), radiusSq, cone, h);
+            }
+        }
+        float reach = (float)r * GRID_CELL_SIZE;
+        if (h->n == h->k && h->dSq[0] <= reach * reach) break;
+    }
+    SpatialNearestSort(h);
+}
+
+void SpatialQueryRect(const SpatialGrid *g, Rectangle rect, SpatialItemFn fn, void *ctx) {
+    assert(g != NULL && fn != NULL);
+    float x1 = rect.x + rect.width;
+    float y1 = rect.y + rect.height;
+    int minCol = (int)floorf(rect.x / GRID_CELL_SIZE);
+    int minRow = (int)floorf(rect.y / GRID_CELL_SIZE);
+    int maxCol = (int)floorf(x1 / GRID_CELL_SIZE);
+    int maxRow = (int)floorf(y1 / GRID_CELL_SIZE);
+    if (minCol < 0) minCol = 0;
+    if (minRow < 0) minRow = 0;
+    if (maxCol > g->cols - 1) maxCol = g->cols - 1;
+    if (maxRow > g->rows - 1) maxRow = g->rows - 1;
+
+    for (int row = minRow; row <= maxRow; row++) {
+        for (int col = minCol; col <= maxCol; col++) {
+            for (int i = SpatialHead(g, row * g->cols + col); i != -1; i = g->next[i]) {
+                Vector2 p = SpatialPos(g, i);
+                if (p.x < rect.x || p.x > x1 || p.y < rect.y || p.y > y1) continue;
+                fn(ctx, i);
+            }
+        }
+    }
+}
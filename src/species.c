@@ -0,0 +1,168 @@
+#include "species.h"
+#include "raylib.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ── Internal helpers ────────────────────────────────────────── */
+
+/* Integer finalizer (murmur3 fmix32) — spreads feature ids over all bits */
+static unsigned Mix32(unsigned x) {
+    x ^= x >> 16; x *= 0x85ebca6bu;
+    x ^= x >> 13; x *= 0xc2b2ae35u;
+    x ^= x >> 16;
+    return x;
+}
+
+static void SimHashAdd(int acc[32], unsigned feature) {
+    unsigned h = Mix32(feature);
+    for (int b = 0; b < 32; b++) acc[b] += (h >> b & 1u) ? 1 : -1;
+}
+
+static int PopCount32(unsigned x) {
+    int n = 0;
+    while (x) { x &= x - 1; n++; }
+    return n;
+}
+
+static void GrowSpecies(SpeciesTable *t) {
+    int cap = t->cap > 0 ? t->cap * 2 : 64;
+    Species  *list   = realloc(t->list,      (size_t)cap * sizeof(*t->list));
+    unsigned *hashes = realloc(t->hashes,    (size_t)cap * sizeof(*t->hashes));
+    int      *free_  = realloc(t->freeSlots, (size_t)cap * sizeof(*t->freeSlots));
+    if (list)   t->list      = list;
+    if (hashes) t->hashes    = hashes;
+    if (free_)  t->freeSlots = free_;
+    if (!list || !hashes || !free_) TraceLog(LOG_FATAL, "SPECIES: out of memory growing table to %d", cap);
+    memset(t->list + t->cap, 0, (size_t)(cap - t->cap) * sizeof(*t->list));   /* rep = NULL */
+    t->cap = cap;
+}
+
+static int FoundSpecies(SpeciesTable *t, const Genome *g, unsigned hash) {
+    int slot;
+    if (t->freeCount > 0) {
+        slot = t->freeSlots[--t->freeCount];
+    } else {
+        if (t->count == t->cap) GrowSpecies(t);
+        slot = t->count++;
+    }
+    Species *sp = &t->list[slot];
+    Genome *rep = realloc(sp->rep, GenomeSize(g));
+    if (!rep) TraceLog(LOG_FATAL, "SPECIES: out of memory copying a representative genome");
+    memcpy(rep, g, GenomeSize(g));
+    sp->rep     = rep;
+    sp->id      = t->nextId++;
+    sp->members = 0;
+    sp->hash    = hash;
+    t->hashes[slot] = hash;
+    t->alive++;
+    return slot;
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+void SpeciesInit(SpeciesTable *t) {
+    assert(t != NULL);
+    memset(t, 0, sizeof(*t));
+}
+
+void SpeciesFree(SpeciesTable *t) {
+    assert(t != NULL);
+    for (int i = 0; i < t->count; i++) free(t->list[i].rep);
+    free(t->list);
+    free(t->hashes);
+    free(t->freeSlots);
+    memset(t, 0, sizeof(*t));
+}
+
+unsigned SpeciesTopologyHash(const Genome *g) {
+    assert(g != NULL);
+    int acc[32] = { 0 };
+    for (int i = 0; i < g->connCount; i++) {
+        uint64_t inn = NNConnInnovation(g, &g->conns[i]);
+        SimHashAdd(acc, Mix32((unsigned)(inn >> 32)) ^ (unsigned)inn);
+    }
+    /* Hidden nodes contribute their marking and activation; the top bit
+       keeps these features apart from the connections' */
+    for (int h = 0; h < g->hiddenCount; h++) {
+        SimHashAdd(acc, Mix32(GenomeMarks(g)[h] * ACT_COUNT + GenomeHiddenAct(g, h)) | 1u << 31);
+    }
+    unsigned hash = 0;
+    for (int b = 0; b < 32; b++) {
+        if (acc[b] > 0) hash |= 1u << b;
+    }
+    return hash;
+}
+
+float SpeciesDistance(const Genome *a, const Genome *b) {
+    assert(a != NULL && b != NULL);
+
+    /* Connections are aligned by innovation number; index a's by it */
+    static GeneIndex index;
+    GeneIndexClear(&index);
+    for (int i = 0; i < a->connCount; i++) GeneIndexPut(&index, NNConnInnovation(a, &a->conns[i]), i);
+
+    int   matched = 0;
+    float wDiff   = 0.0f;
+    for (int i = 0; i < b->connCount; i++) {
+        int ai = GeneIndexGet(&index, NNConnInnovation(b, &b->conns[i]));
+        if (ai >= 0) {
+            matched++;
+            wDiff += fabsf(NNConnWeight(&a->conns[ai]) - NNConnWeight(&b->conns[i]));
+        }
+    }
+
+    int unmatched = (a->connCount - matched) + (b->connCount - matched);
+    int n         = a->connCount > b->connCount ? a->connCount : b->connCount;
+    if (n < 1) n = 1;
+
+    float d = SPECIES_C_DISJOINT * (float)unmatched / (float)n;
+    if (matched > 0) d += SPECIES_C_WEIGHT * wDiff / (float)matched;
+    return d;
+}
+
+int SpeciesAssign(SpeciesTable *t, const Genome *g, int parentSpecies) {
+    assert(t != NULL && g != NULL);
+
+    /* Most children stay in their parent's species — one comparison */
+    if (parentSpecies >= 0 && parentSpecies < t->count && t->list[parentSpecies].members > 0
+        && SpeciesDistance(t->list[parentSpecies].rep, g) < SPECIES_THRESHOLD) {
+        t->list[parentSpecies].members++;
+        return parentSpecies;
+    }
+
+    /* Otherwise compare against representatives with a nearby hash only */
+    unsigned hash = SpeciesTopologyHash(g);
+    int      best = -1;
+    float    bestD = SPECIES_THRESHOLD;
+    for (int i = 0; i < t->count; i++) {
+        if (t->list[i].members == 0 || i == parentSpecies) continue;
+        if (PopCount32(t->hashes[i] ^ hash) > SPECIES_HASH_RADIUS) continue;
+        float d = SpeciesDistance(t->list[i].rep, g);
+        if (d < bestD) {
+            bestD = d;
+            best  = i;
+        }
+    }
+
+    if (best < 0) best = FoundSpecies(t, g, hash);
+    t->list[best].members++;
+    return best;
+}
+
+void SpeciesJoin(SpeciesTable *t, int species) {
+    assert(t != NULL && species >= 0 && species < t->count);
+    assert(t->list[species].members > 0);
+    t->list[species].members++;
+}
+
+void SpeciesRelease(SpeciesTable *t, int species) {
+    assert(t != NULL && species >= 0 && species < t->count);
+    assert(t->list[species].members > 0);
+    if (--t->list[species].members == 0) {
+        t->freeSlots[t->freeCount++] = species;
+        t->alive--;
+    }
+}
@@ -0,0 +1,123 @@
+#include "timer_wheel.h"
+
+#include "raylib.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TW_MASK     (TIMER_WHEEL_SLOTS - 1)
+#define TW_HORIZON  (1 << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS))
+
+/* ── Internal helpers ────────────────────────────────────────── */
+
+/* File item into the slot for its due tick: the lowest level whose span
+   covers the distance from now. due == now files into the current level-0
+   slot, which only happens while cascading just before that slot fires. */
+static void Link(TimerWheel *tw, int item) {
+    int due   = tw->due[item];
+    int delta = due - tw->now;
+    assert(delta >= 0 && delta < TW_HORIZON);
+
+    int level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >= 1 << (TIMER_WHEEL_BITS * (level + 1))) level++;
+    int s = level * TIMER_WHEEL_SLOTS + ((due >> (TIMER_WHEEL_BITS * level)) & TW_MASK);
+
+    tw->slot[item] = s;
+    tw->prev[item] = -1;
+    tw->next[item] = tw->head[s];
+    if (tw->head[s] != -1) tw->prev[tw->head[s]] = item;
+    tw->head[s] = item;
+}
+
+static void Unlink(TimerWheel *tw, int item) {
+    int s = tw->slot[item];
+    if (tw->prev[item] != -1) tw->next[tw->prev[item]] = tw->next[item];
+    else                      tw->head[s]              = tw->next[item];
+    if (tw->next[item] != -1) tw->prev[tw->next[item]] = tw->prev[item];
+    tw->slot[item] = -1;
+}
+
+/* Re-file every item of one upper-level slot; each lands at a lower level */
+static void Cascade(TimerWheel *tw, int level, int s) {
+    int i = tw->head[level * TIMER_WHEEL_SLOTS + s];
+    tw->head[level * TIMER_WHEEL_SLOTS + s] = -1;
+    while (i != -1) {
+        int next = tw->next[i];
+        Link(tw, i);
+        i = next;
+    }
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+void TimerWheelInit(TimerWheel *tw, int now) {
+    assert(tw != NULL);
+    memset(tw, 0, sizeof(*tw));
+    memset(tw->head, -1, sizeof(tw->head));
+    tw->now = now;
+}
+
+void TimerWheelFree(TimerWheel *tw) {
+    assert(tw != NULL);
+    free(tw->next);
+    free(tw->prev);
+    free(tw->slot);
+    free(tw->due);
+    memset(tw, 0, sizeof(*tw));
+}
+
+void TimerWheelReserve(TimerWheel *tw, int cap) {
+    assert(tw != NULL);
+    if (cap <= tw->cap) return;
+
+    int *next = realloc(tw->next, (size_t)cap * sizeof(*tw->next));
+    int *prev = realloc(tw->prev, (size_t)cap * sizeof(*tw->prev));
+    int *slot = realloc(tw->slot, (size_t)cap * sizeof(*tw->slot));
+    int *due  = realloc(tw->due,  (size_t)cap * sizeof(*tw->due));
+    if (next) tw->next = next;
+    if (prev) tw->prev = prev;
+    if (slot) tw->slot = slot;
+    if (due)  tw->due  = due;
+    if (!next || !prev || !slot || !due) TraceLog(LOG_FATAL, "TIMER: out of memory growing timer wheel to %d", cap);
+
+    memset(tw->slot + tw->cap, -1, (size_t)(cap - tw->cap) * sizeof(*tw->slot));
+    tw->cap = cap;
+}
+
+void TimerWheelSchedule(TimerWheel *tw, int item, int due) {
+    assert(tw != NULL && item >= 0 && item < tw->cap);
+    if (tw->slot[item] != -1) Unlink(tw, item);
+    else                      tw->count++;
+
+    if (due <= tw->now)                due = tw->now + 1;
+    if (due - tw->now >= TW_HORIZON)   due = tw->now + TW_HORIZON - 1;
+    tw->due[item] = due;
+    Link(tw, item);
+}
+
+void TimerWheelCancel(TimerWheel *tw, int item) {
+    assert(tw != NULL && item >= 0 && item < tw->cap);
+    if (tw->slot[item] == -1) return;
+    Unlink(tw, item);
+    tw->count--;
+}
+
+void TimerWheelAdvance(TimerWheel *tw, void (*fire)(void *ctx, int item), void *ctx) {
+    assert(tw != NULL && fire != NULL);
+    int now = ++tw->now;
+
+    /* Cascade every upper wheel whose lower cursors all wrapped this tick */
+    for (int level = TIMER_WHEEL_LEVELS - 1; level >= 1; level--) {
+        if (now & ((1 << (TIMER_WHEEL_BITS * level)) - 1)) continue;
+        Cascade(tw, level, (now >> (TIMER_WHEEL_BITS * level)) & TW_MASK);
+    }
+
+    int s = now & TW_MASK;
+    while (tw->head[s] != -1) {
+        int item = tw->head[s];
+        assert(tw->due[item] == now);
+        Unlink(tw, item);
+        tw->count--;
+        fire(ctx, item);
+    }
+}
@@ -0,0 +1,11 @@
+#include "timing.h"
+
+#include <time.h>
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+double TimingSeconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
@@ -6,20 +6,24 @@
 #include "settings.h"
 #include "config.h"
 #include "history.h"
+#include "popstats.h"
+#include "workers.h"
 
+#include <assert.h>
 #include <string.h>
 
 /* ── Internal chart helper ───────────────────────────────────── */
 
-/* Draw a line chart from a float ring buffer.
-   data  : ring buffer array of length HISTORY_LEN
-   count : number of valid samples
-   head  : index of the NEXT write position (oldest sample at head when full)
+/* Draw a line chart of one history series over the whole run.
+   The tier is chosen by HistoryChartTier, so at most HISTORY_TIER_LEN
+   buckets are visited whatever the run length. Buckets are binned into
+   pixel columns: each column shows the min/max envelope as a faint
+   vertical bar and the mean as the polyline.
    minV/maxV: value range for vertical scaling
-   lineColor: color of the polyline
+   lineColor: color of the mean line (envelope uses it at low alpha)
    label : short text shown in top-left corner of chart */
 static void DrawLineChart(int x, int y, int w, int h,
-                           const float *data, int count, int head,
+                           const History *hist, HistorySeries series,
                            float minV, float maxV,
                            Color lineColor, const char *label)
 {
@@ -30,29 +34,56 @@ static void DrawLineChart(int x, int y, int w, int h,
     /* Label */
     DrawText(label, x + 3, y + 2, 10, (Color){ 160, 160, 180, 255 });
 
-    if (count < 2) return;
+    const HistoryTier *tier = &hist->tiers[HistoryChartTier(hist)];
+    int count = tier->count;
+    if (count < 2 || w < 2) return;
 
     float range = maxV - minV;
     if (range < 0.0001f) range = 0.0001f;
 
-    int   samples  = (count < HISTORY_LEN) ? count : HISTORY_LEN;
-    /* oldest sample index in the ring */
-    int   startIdx = (count < HISTORY_LEN) ? 0 : head;
+    /* oldest bucket index in the ring */
+    int startIdx = (count < HISTORY_TIER_LEN) ? 0 : tier->head;
+    const HistoryBucket *data = tier->data[series];
+    Color envColor = Fade(lineColor, 0.35f);
 
     float prevX = 0.0f, prevY = 0.0f;
-
-    for (int i = 0; i < samples; i++) {
-        int   idx   = (startIdx + i) % HISTORY_LEN;
-        float val   = data[idx];
-        float normX = (float)i / (float)(HISTORY_LEN - 1);
-        float normY = (val - minV) / range;
-        if (normY < 0.0f) normY = 0.0f;
-        if (normY > 1.0f) normY = 1.0f;
-
-        float px = (float)x + normX * (float)(w - 1);
-        float py = (float)(y + h - 1) - normY * (float)(h - 3);
-
-        if (i > 0) {
+    int   i = 0;
+
+    for (int col = 0; col < w && i < count; col++) {
+        /* Buckets [i, end) fall into this pixel column */
+        int end = (col == w - 1) ? count : (int)((long long)(col + 1) * count / w);
+        if (end <= i) continue;
+
+        float lo = 0.0f, hi = 0.0f, sum = 0.0f;
+        for (int k = i; k < end; k++) {
+            const HistoryBucket *b = &data[(startIdx + k) % HISTORY_TIER_LEN];
+            if (k == i || b->min < lo) lo = b->min;
+            if (k == i || b->max > hi) hi = b->max;
+            sum += b->mean;
+        }
+        float mean = sum / (float)(end - i);
+        i = end;
+
+        float normLo   = (lo - minV)   / range;
+        float normHi   = (hi - minV)   / range;
+        float normMean = (mean - minV) / range;
+        if (normLo < 0.0f) normLo = 0.0f;
+        if (normLo > 1.0f) normLo = 1.0f;
+        if (normHi < 0.0f) normHi = 0.0f;
+        if (normHi > 1.0f) normHi = 1.0f;
+        if (normMean < 0.0f) normMean = 0.0f;
+        if (normMean > 1.0f) normMean = 1.0f;
+
+        float base = (float)(y + h - 1);
+        float span = (float)(h - 3);
+        float px   = (float)(x + col);
+        float py   = base - normMean * span;
+
+        if (normHi > normLo) {
+            DrawLine((int)px, (int)(base - normLo * span),
+                     (int)px, (int)(base - normHi * span), envColor);
+        }
+        if (col > 0) {
             DrawLine((int)prevX, (int)prevY, (int)px, (int)py, lineColor);
         }
         prevX = px;
@@ -60,46 +91,71 @@ static void DrawLineChart(int x, int y, int w, int h,
     }
 }
 
-/* Overload for integer ring buffers — converts to float on-the-fly */
-static void DrawLineChartInt(int x, int y, int w, int h,
-                              const int *data, int count, int head,
-                              float minV, float maxV,
-                              Color lineColor, const char *label)
+/* Draw the current distribution of one trait: one bar per histogram bin,
+   the 10th–90th percentile band shaded behind the bars and the median as a
+   vertical line. O(POPSTATS_BINS) — no creature scan. */
+static void DrawTraitHistogram(int x, int y, int w, int h,
+                               const PopStats *stats, Trait t,
+                               Color barColor, const char *label)
 {
-    /* Dark background */
     DrawRectangle(x, y, w, h, (Color){ 10, 10, 20, 240 });
-    /* Border */
     DrawRectangleLines(x, y, w, h, (Color){ 60, 60, 80, 200 });
-    /* Label */
-    DrawText(label, x + 3, y + 2, 10, (Color){ 160, 160, 180, 255 });
-
-    if (count < 2) return;
 
-    float range = maxV - minV;
-    if (range < 0.0001f) range = 0.0001f;
-
-    int samples  = (count < HISTORY_LEN) ? count : HISTORY_LEN;
-    int startIdx = (count < HISTORY_LEN) ? 0 : head;
+    if (stats->count > 0) {
+        const int *bins = stats->traits[t].bins;
+        int peak = 1;
+        for (int b = 0; b < POPSTATS_BINS; b++) {
+            if (bins[b] > peak) peak = bins[b];
+        }
 
-    float prevX = 0.0f, prevY = 0.0f;
+        float lo, hi;
+        TraitRange(t, &lo, &hi);
+        float scale = (float)(w - 2) / (hi - lo);
+        float p10   = PopStatsQuantile(stats, t, 0.10f);
+        float p50   = PopStatsQuantile(stats, t, 0.50f);
+        float p90   = PopStatsQuantile(stats, t, 0.90f);
+
+        /* Percentile band */
+        int bandX0 = x + 1 + (int)((p10 - lo) * scale);
+        int bandX1 = x + 1 + (int)((p90 - lo) * scale);
+        DrawRectangle(bandX0, y + 1, bandX1 - bandX0 + 1, h - 2, Fade(barColor, 0.15f));
+
+        /* Bars */
+        float barW = (float)(w - 2) / POPSTATS_BINS;
+        for (int b = 0; b < POPSTATS_BINS; b++) {
+            if (bins[b] == 0) continue;
+            float barH = (float)(h - 14) * (float)bins[b] / (float)peak;
+            DrawRectangleRec((Rectangle){ (float)(x + 1) + b * barW, (float)(y + h - 1) - barH,
+                                          barW > 1.0f ? barW - 1.0f : barW, barH },
+                             barColor);
+        }
 
-    for (int i = 0; i < samples; i++) {
-        int   idx   = (startIdx + i) % HISTORY_LEN;
-        float val   = (float)data[idx];
-        float normX = (float)i / (float)(HISTORY_LEN - 1);
-        float normY = (val - minV) / range;
-        if (normY < 0.0f) normY = 0.0f;
-        if (normY > 1.0f) normY = 1.0f;
+        /* Median */
+        int medX = x + 1 + (int)((p50 - lo) * scale);
+        DrawLine(medX, y + 1, medX, y + h - 1, RAYWHITE);
+    }
 
-        float px = (float)x + normX * (float)(w - 1);
-        float py = (float)(y + h - 1) - normY * (float)(h - 3);
+    DrawText(label, x + 3, y + 2, 10, (Color){ 160, 160, 180, 255 });
+}
 
-        if (i > 0) {
-            DrawLine((int)prevX, (int)prevY, (int)px, (int)py, lineColor);
+/* Semicolon-separated trait names for the chart combo box, built once from
+   TraitName so the entries always follow the Trait enum. */
+static const char *TraitComboText(void)
+{
+    static char text[256];
+    if (text[0] == '\0') {
+        size_t len = 0;
+        for (int t = 0; t < TRAIT_COUNT; t++) {
+            const char *name = TraitName((Trait)t);
+            size_t n = strlen(name);
+            assert(len + n + 2 <= sizeof(text));
+            if (t > 0) text[len++] = ';';
+            memcpy(text + len, name, n);
+            len += n;
         }
-        prevX = px;
-        prevY = py;
+        text[len] = '\0';
     }
+    return text;
 }
 
 /* ── Public API ──────────────────────────────────────────────── */
@@ -125,9 +181,17 @@ void UIDraw(const Simulation *s, SimSettings *settings) {
     /* ── Stats ───────────────────────────────────────────────── */
     DrawText(TextFormat("Tick: %d",  s->world.tick),               px, py, 12, LIGHTGRAY); py += lineH;
     DrawText(TextFormat("Pop:  %d",  SimulationAliveCount(s)),     px, py, 12, LIGHTGRAY); py += lineH;
-    DrawText(TextFormat("Food: %d",  WorldFoodCount(&s->world)),   px, py, 12, LIGHTGRAY); py += lineH;
-    DrawText(TextFormat("Born: %d",  s->totalBirths),              px, py, 12, (Color){ 100, 210, 255, 255 }); py += lineH;
+    DrawText(TextFormat("Food: %d (meat %d)", WorldFoodCount(&s->world), s->world.meatCount), px, py, 12, LIGHTGRAY); py += lineH;
+    DrawText(TextFormat("Born: %d (%d sexual)", s->totalBirths, s->sexualBirths),
+             px, py, 12, (Color){ 100, 210, 255, 255 }); py += lineH;
     DrawText(TextFormat("Dead: %d",  s->totalDeaths),              px, py, 12, (Color){ 220, 100, 100, 255 }); py += lineH;
+    DrawText(TextFormat("Kills: %d", s->totalKills),               px, py, 12, (Color){ 255, 140, 60, 255 }); py += lineH;
+    DrawText(TextFormat("Species: %d", s->species.alive),          px, py, 12, (Color){ 220, 180, 255, 255 }); py += lineH;
+    DrawText(TextFormat("Sick: %d (%d infections)", s->sickCount, s->totalInfections),
+             px, py, 12, (Color){ 200, 90, 255, 255 }); py += lineH;
+    DrawText(TextFormat("Season: %s", settings->seasons ? SeasonAt(s->world.tick)->name : "off"),
+             px, py, 12, LIGHTGRAY); py += lineH;
+    DrawText(TextFormat("Threads: %d x %d strips", WorkersCount(), s->domain.stripCount), px, py, 12, GRAY); py += lineH;
 
     py += gap;
     DrawLine(panelX, py, panelX + panelW, py, (Color){ 60, 60, 80, 180 });
@@ -153,15 +217,16 @@ void UIDraw(const Simulation *s, SimSettings *settings) {
     if (settings->speedMult > 20) settings->speedMult = 20;
     py += 26;
 
-    /* Food max cap slider (100..8000) */
-    float foodF = (float)settings->foodTarget;
+    /* Food max cap slider (100..food pool cap) */
+    float foodF   = (float)settings->foodTarget;
+    int   foodMax = s->world.maxFood > 100 ? s->world.maxFood : 100;
     GuiSliderBar((Rectangle){ (float)(px + 50), (float)py, (float)(panelW - 116), 16.0f },
                  "FoodMax",
                  TextFormat("%d", settings->foodTarget),
-                 &foodF, 100.0f, 8000.0f);
+                 &foodF, 100.0f, (float)foodMax);
     settings->foodTarget = (int)(foodF + 0.5f);
-    if (settings->foodTarget < 100)  settings->foodTarget = 100;
-    if (settings->foodTarget > 8000) settings->foodTarget = 8000;
+    if (settings->foodTarget < 100)     settings->foodTarget = 100;
+    if (settings->foodTarget > foodMax) settings->foodTarget = foodMax;
     py += 26;
 
     /* Food spawn rate slider (0.5..20.0 items/sec) */
@@ -193,6 +258,27 @@ void UIDraw(const Simulation *s, SimSettings *settings) {
     if (settings->minPopulation > 500) settings->minPopulation = 500;
     py += 26;
 
+    /* Staggered sensing toggle; K adapts to the frame budget while on */
+    GuiCheckBox((Rectangle){ (float)px, (float)py, 14.0f, 14.0f },
+                TextFormat("Stagger sensing (K=%d, sim %.1f ms/frame)",
+                           settings->senseCohorts, settings->simFrameTime * 1000.0f),
+                &settings->staggerSensing);
+    py += 22;
+
+    /* Sexual reproduction (mated pairs) or asexual cloning; body collisions */
+    GuiCheckBox((Rectangle){ (float)px, (float)py, 14.0f, 14.0f }, "Sexual reproduction", &settings->sexual);
+    GuiCheckBox((Rectangle){ (float)(px + 150), (float)py, 14.0f, 14.0f }, "Collisions", &settings->collisions);
+    py += 22;
+
+    /* Events: seasonal food supply, spontaneous outbreaks, manual outbreak */
+    GuiCheckBox((Rectangle){ (float)px, (float)py, 14.0f, 14.0f }, "Seasons", &settings->seasons);
+    GuiCheckBox((Rectangle){ (float)(px + 90), (float)py, 14.0f, 14.0f }, "Outbreaks", &settings->outbreaks);
+    if (GuiButton((Rectangle){ (float)(px + 190), (float)(py - 3), (float)(panelW - 206), 20.0f },
+                  TextFormat("Infect %d", DISEASE_OUTBREAK_SEEDS))) {
+        settings->outbreakSeeds = DISEASE_OUTBREAK_SEEDS;
+    }
+    py += 22;
+
     py += gap;
     DrawLine(panelX, py, panelX + panelW, py, (Color){ 60, 60, 80, 180 });
     py += gap + 2;
@@ -203,32 +289,58 @@ void UIDraw(const Simulation *s, SimSettings *settings) {
 
     const History *h = &s->history;
 
-    DrawLineChartInt(
+    DrawLineChart(
         px, py, chartW, chartH,
-        h->population, h->count, h->head,
-        0.0f, (float)MAX_CREATURES,
+        h, HIST_POPULATION,
+        0.0f, (float)s->maxCreatures,
         (Color){ 100, 210, 100, 255 }, "Population");
     py += chartH + 6;
 
     DrawLineChart(
         px, py, chartW, chartH,
-        h->avgSpeed, h->count, h->head,
-        0.0f, 400.0f,
-        (Color){ 100, 180, 255, 255 }, "Avg Speed");
+        h, HIST_FOOD,
+        0.0f, (float)s->world.maxFood,
+        (Color){ 80, 200, 80, 255 }, "Food");
+    py += chartH + 6;
+
+    float speciesPeak = HistoryChartMax(h, HIST_SPECIES);
+    DrawLineChart(
+        px, py, chartW, chartH,
+        h, HIST_SPECIES,
+        0.0f, speciesPeak > 10.0f ? speciesPeak * 1.1f : 10.0f,
+        (Color){ 220, 180, 255, 255 }, "Species");
     py += chartH + 6;
 
+    /* ── Trait distribution ──────────────────────────────────── */
+    GuiComboBox((Rectangle){ (float)px, (float)py, (float)chartW, 20.0f },
+                TraitComboText(), &settings->chartTrait);
+    if (settings->chartTrait < 0 || settings->chartTrait >= TRAIT_COUNT) settings->chartTrait = TRAIT_SPEED;
+    py += 26;
+
+    Trait trait = (Trait)settings->chartTrait;
+    float traitLo, traitHi;
+    TraitRange(trait, &traitLo, &traitHi);
+
     DrawLineChart(
         px, py, chartW, chartH,
-        h->avgMetabolism, h->count, h->head,
-        0.0f, 10.0f,
-        (Color){ 255, 160, 80, 255 }, "Avg Metabolism");
+        h, (HistorySeries)(HIST_TRAIT_MEAN + trait),
+        traitLo, traitHi,
+        (Color){ 100, 180, 255, 255 }, TextFormat("Avg %s", TraitName(trait)));
     py += chartH + 6;
 
-    DrawLineChartInt(
+    DrawTraitHistogram(
         px, py, chartW, chartH,
-        h->food, h->count, h->head,
-        0.0f, 8000.0f,
-        (Color){ 80, 200, 80, 255 }, "Food");
+        &s->stats, trait,
+        (Color){ 255, 160, 80, 255 }, TextFormat("%s now", TraitName(trait)));
+    py += chartH + 4;
+
+    DrawText(TextFormat("p10 %.2f  p50 %.2f  p90 %.2f  sd %.2f",
+                        PopStatsQuantile(&s->stats, trait, 0.10f),
+                        PopStatsQuantile(&s->stats, trait, 0.50f),
+                        PopStatsQuantile(&s->stats, trait, 0.90f),
+                        PopStatsStdDev(&s->stats, trait)),
+             px, py, 10, GRAY);
+    py += lineH;
 
     (void)py;  /* suppress unused-variable warning */
 }
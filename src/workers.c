@@ -0,0 +1,185 @@
+/* Worker pool — deliberately does not include raylib.h so that <windows.h>
+   can be used here without the well-known name clashes (Rectangle, DrawText…). */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "workers.h"
+#include "config.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* ── Platform primitives ─────────────────────────────────────── */
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+typedef HANDLE             WkThread;
+typedef SRWLOCK            WkMutex;
+typedef CONDITION_VARIABLE WkCond;
+
+static void WkMutexInit(WkMutex *m)            { InitializeSRWLock(m); }
+static void WkMutexDestroy(WkMutex *m)         { (void)m; }
+static void WkLock(WkMutex *m)                 { AcquireSRWLockExclusive(m); }
+static void WkUnlock(WkMutex *m)               { ReleaseSRWLockExclusive(m); }
+static void WkCondInit(WkCond *c)              { InitializeConditionVariable(c); }
+static void WkCondDestroy(WkCond *c)           { (void)c; }
+static void WkWait(WkCond *c, WkMutex *m)      { SleepConditionVariableSRW(c, m, INFINITE, 0); }
+static void WkBroadcast(WkCond *c)             { WakeAllConditionVariable(c); }
+
+static int HardwareThreads(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+}
+#else
+#include <pthread.h>
+#include <unistd.h>
+
+typedef pthread_t       WkThread;
+typedef pthread_mutex_t WkMutex;
+typedef pthread_cond_t  WkCond;
+
+static void WkMutexInit(WkMutex *m)            { pthread_mutex_init(m, NULL); }
+static void WkMutexDestroy(WkMutex *m)         { pthread_mutex_destroy(m); }
+static void WkLock(WkMutex *m)                 { pthread_mutex_lock(m); }
+static void WkUnlock(WkMutex *m)               { pthread_mutex_unlock(m); }
+static void WkCondInit(WkCond *c)              { pthread_cond_init(c, NULL); }
+static void WkCondDestroy(WkCond *c)           { pthread_cond_destroy(c); }
+static void WkWait(WkCond *c, WkMutex *m)      { pthread_cond_wait(c, m); }
+static void WkBroadcast(WkCond *c)             { pthread_cond_broadcast(c); }
+
+static int HardwareThreads(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+#endif
+
+/* ── Pool state ──────────────────────────────────────────────── */
+
+static struct {
+    int         count;        /* threads executing jobs, including the caller */
+    WkThread    threads[WORKER_THREADS_MAX];
+    WkMutex     lock;
+    WkCond      wake;         /* signalled when a new phase starts or on quit */
+    WkCond      done;         /* signalled when the last job of a phase ends  */
+    WorkerJobFn fn;
+    void       *ctx;
+    int         jobCount;
+    int         nextJob;      /* next job index to hand out                    */
+    int         pending;      /* jobs handed out or waiting, not yet finished  */
+    unsigned    generation;   /* bumped once per phase                         */
+    bool        quit;
+} s_pool = { .count = 1 };
+
+/* Grab and run jobs of the current phase until none are left.
+   Called with the lock held; returns with the lock held. */
+static void RunJobsLocked(void) {
+    while (s_pool.nextJob < s_pool.jobCount) {
+        int job = s_pool.nextJob++;
+        WkUnlock(&s_pool.lock);
+        s_pool.fn(s_pool.ctx, job);
+        WkLock(&s_pool.lock);
+        if (--s_pool.pending == 0) WkBroadcast(&s_pool.done);
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI WorkerMain(LPVOID arg)
+#else
+static void *WorkerMain(void *arg)
+#endif
+{
+    (void)arg;
+    unsigned seen = 0;
+
+    WkLock(&s_pool.lock);
+    for (;;) {
+        while (!s_pool.quit && s_pool.generation == seen) WkWait(&s_pool.wake, &s_pool.lock);
+        if (s_pool.quit) break;
+        seen = s_pool.generation;
+        RunJobsLocked();
+    }
+    WkUnlock(&s_pool.lock);
+    return 0;
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+void WorkersInit(int threadCount) {
+    assert(s_pool.count == 1);
+
+    if (threadCount <= 0) threadCount = HardwareThreads();
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > WORKER_THREADS_MAX) threadCount = WORKER_THREADS_MAX;
+
+    WkMutexInit(&s_pool.lock);
+    WkCondInit(&s_pool.wake);
+    WkCondInit(&s_pool.done);
+    s_pool.generation = 0;
+    s_pool.quit       = false;
+
+    /* Slot 0 is the calling thread — only spawn the extra ones */
+    for (int t = 1; t < threadCount; t++) {
+#ifdef _WIN32
+        s_pool.threads[t] = CreateThread(NULL, 0, WorkerMain, NULL, 0, NULL);
+        if (s_pool.threads[t] == NULL) break;
+#else
+        if (pthread_create(&s_pool.threads[t], NULL, WorkerMain, NULL) != 0) break;
+#endif
+        s_pool.count = t + 1;
+    }
+}
+
+void WorkersShutdown(void) {
+    if (s_pool.count <= 1) return;
+
+    WkLock(&s_pool.lock);
+    s_pool.quit = true;
+    WkBroadcast(&s_pool.wake);
+    WkUnlock(&s_pool.lock);
+
+    for (int t = 1; t < s_pool.count; t++) {
+#ifdef _WIN32
+        WaitForSingleObject(s_pool.threads[t], INFINITE);
+        CloseHandle(s_pool.threads[t]);
+#else
+        pthread_join(s_pool.threads[t], NULL);
+#endif
+    }
+
+    WkCondDestroy(&s_pool.done);
+    WkCondDestroy(&s_pool.wake);
+    WkMutexDestroy(&s_pool.lock);
+    s_pool.count = 1;
+}
+
+int WorkersCount(void) {
+    return s_pool.count;
+}
+
+void WorkersRun(WorkerJobFn fn, void *ctx, int jobCount) {
+    assert(fn != NULL);
+    if (jobCount <= 0) return;
+
+    /* Single-threaded: no synchronisation needed */
+    if (s_pool.count <= 1 || jobCount == 1) {
+        for (int j = 0; j < jobCount; j++) fn(ctx, j);
+        return;
+    }
+
+    WkLock(&s_pool.lock);
+    s_pool.fn       = fn;
+    s_pool.ctx      = ctx;
+    s_pool.jobCount = jobCount;
+    s_pool.nextJob  = 0;
+    s_pool.pending  = jobCount;
+    s_pool.generation++;
+    WkBroadcast(&s_pool.wake);
+
+    RunJobsLocked();
+    while (s_pool.pending > 0) WkWait(&s_pool.done, &s_pool.lock);
+    WkUnlock(&s_pool.lock);
+}
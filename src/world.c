@@ -1,75 +1,162 @@
 #include "world.h"
+#include "world_layers.h"
 
 #include <assert.h>
+#include <math.h>
+#include <stdlib.h>
 #include <string.h>
+#include "rlgl.h"
 
 /* ── Internal helpers ────────────────────────────────────────── */
 
-/* Compute the flat grid cell index for a world position. */
-static inline int FoodCellOf(float x, float y) {
-    int col = (int)(x / GRID_CELL_SIZE) % GRID_COLS;
-    int row = (int)(y / GRID_CELL_SIZE) % GRID_ROWS;
-    return row * GRID_COLS + col;
+/* Grow the food pool geometrically so it holds at least `need` slots
+   (never beyond maxFood). New slots start out eaten (free).
+   Returns false if the pool is already at maxFood. */
+static bool GrowFoodPool(World *w, int need) {
+    if (need <= w->foodCap) return true;
+    if (w->foodCap >= w->maxFood) return false;
+
+    int cap = w->foodCap > 0 ? w->foodCap : POOL_INITIAL_CAPACITY;
+    while (cap < need) cap *= 2;
+    if (cap > w->maxFood) cap = w->maxFood;
+
+    Food *food   = realloc(w->food,     (size_t)cap * sizeof(*w->food));
+    int  *slots  = realloc(w->foodFree, (size_t)cap * sizeof(*w->foodFree));
+    if (food)   w->food     = food;
+    if (slots)  w->foodFree = slots;
+    if (!food || !slots) TraceLog(LOG_FATAL, "WORLD: out of memory growing food pool to %d", cap);
+    TimerWheelReserve(&w->meatTimers, cap);
+    SpatialReserve(&w->foodGrid, cap);
+    SpatialBind(&w->foodGrid, &w->food->position, sizeof(*w->food));
+
+    /* Push new slots highest first so they are handed out in index order */
+    for (int i = cap - 1; i >= w->foodCap; i--) {
+        w->food[i].eaten = true;
+        w->foodFree[w->foodFreeCount++] = i;
+    }
+    w->foodCap = cap;
+    return true;
 }
 
 /* Insert food slot i into the spatial grid.
-   The plant's position and eaten=false must already be set. */
+   The item's position, kind and eaten=false must already be set. */
 static void FoodGridInsert(World *w, int i) {
-    int cell           = FoodCellOf(w->plants[i].position.x, w->plants[i].position.y);
-    w->foodGridCell[i] = cell;
-    w->foodGridNext[i] = w->foodGridHead[cell];
-    w->foodGridHead[cell] = i;
+    SpatialInsert(&w->foodGrid, i);
     w->foodCount++;
+    WorldMarkFoodDirty(w, w->foodGrid.cell[i]);
+}
+
+/* Pop a free food slot (O(1)), growing the pool when every slot is in use.
+   Returns -1 if the pool is at maxFood. */
+static int AllocFoodSlot(World *w) {
+    if (w->foodFreeCount == 0 && !GrowFoodPool(w, w->foodCap + 1)) return -1;
+    return w->foodFree[--w->foodFreeCount];
 }
 
-/* Spawn one food item into the first available (eaten) slot.
-   Returns true if a slot was found, false if the pool is full. */
+/* Spawn one plant in a cell drawn by fertility, at a random point inside it.
+   Returns false if the pool is at maxFood. */
 static bool SpawnFood(World *w) {
-    for (int i = 0; i < MAX_FOOD; i++) {
-        if (!w->plants[i].eaten) continue;
-        w->plants[i].position  = (Vector2){
-            (float)GetRandomValue(8, w->width  - 8),
-            (float)GetRandomValue(8, w->height - 8)
-        };
-        w->plants[i].nutrition = FOOD_NUTRITION;
-        w->plants[i].eaten     = false;
-        FoodGridInsert(w, i);
-        return true;
-    }
-    return false;  /* pool full */
+    int i = AllocFoodSlot(w);
+    if (i < 0) return false;
+    int cell = FertilitySample(&w->fertility);
+    w->food[i].position  = (Vector2){
+        (float)(cell % w->gridCols * GRID_CELL_SIZE + GetRandomValue(0, GRID_CELL_SIZE - 1)),
+        (float)(cell / w->gridCols * GRID_CELL_SIZE + GetRandomValue(0, GRID_CELL_SIZE - 1))
+    };
+    w->food[i].nutrition = FOOD_NUTRITION;
+    w->food[i].kind      = FOOD_PLANT;
+    w->food[i].eaten     = false;
+    FoodGridInsert(w, i);
+    return true;
+}
+
+/* Rect query visitor: one food quad */
+typedef struct {
+    const World  *w;
+    float         half;
+    unsigned char alpha;
+} FoodQuads;
+
+static void EmitFoodQuad(void *ctx, int f) {
+    const FoodQuads *q = (const FoodQuads *)ctx;
+    float x = q->w->food[f].position.x;
+    float y = q->w->food[f].position.y;
+    if (q->w->food[f].kind == FOOD_MEAT) rlColor4ub(200, 70, 60, q->alpha);
+    else                                 rlColor4ub(80, 200, 80, q->alpha);
+    rlVertex2f(x - q->half, y - q->half);
+    rlVertex2f(x - q->half, y + q->half);
+    rlVertex2f(x + q->half, y + q->half);
+    rlVertex2f(x + q->half, y - q->half);
+}
+
+/* Timer wheel callback: meat in slot `item` has rotted */
+static void RotMeat(void *ctx, int item) {
+    World *w = (World *)ctx;
+    WorldFoodGridRemove(w, item);
 }
 
 /* ── Public API ──────────────────────────────────────────────── */
 
-void WorldInit(World *w) {
+void WorldInit(World *w, int width, int height, int maxFood, const char *fertility,
+               CellTableMode grid) {
     assert(w != NULL);
+    assert(width % GRID_CELL_SIZE == 0 && height % GRID_CELL_SIZE == 0);
+    assert(maxFood > 0);
     memset(w, 0, sizeof(*w));
 
-    w->width         = WORLD_WIDTH;
-    w->height        = WORLD_HEIGHT;
+    w->width         = width;
+    w->height        = height;
+    w->maxFood       = maxFood;
     w->foodTarget    = FOOD_TARGET;
     w->foodSpawnRate = FOOD_SPAWN_RATE;
     w->foodCount     = 0;
+    TimerWheelInit(&w->meatTimers, w->tick);
 
-    /* Initialize spatial grid heads to -1 (empty linked lists) */
-    memset(w->foodGridHead, -1, sizeof(w->foodGridHead));
-    memset(w->foodGridNext, -1, sizeof(w->foodGridNext));
+    /* Grid is sized once from the world; the food pool grows on demand */
+    w->gridCols     = width  / GRID_CELL_SIZE;
+    w->gridRows     = height / GRID_CELL_SIZE;
+    w->foodDirtyCells = malloc(FOOD_DIRTY_MAX * sizeof(*w->foodDirtyCells));
+    if (!w->foodDirtyCells) TraceLog(LOG_FATAL, "WORLD: out of memory allocating food grid");
+    CellTableInit(&w->foodDirtySet, w->gridCols * w->gridRows, FOOD_DIRTY_MAX, CELL_TABLE_HASHED);
+    SpatialInit(&w->foodGrid, width, height, maxFood, grid);
 
-    /* Mark all slots as available */
-    for (int i = 0; i < MAX_FOOD; i++) w->plants[i].eaten = true;
+    FertilityInit(&w->fertility, w->gridCols, w->gridRows);
+    if (fertility != NULL && strcmp(fertility, "flat") == 0) {
+        /* uniform, as initialized */
+    } else if (fertility != NULL && strcmp(fertility, "noise") != 0 &&
+               FertilityLoadImage(&w->fertility, fertility)) {
+        TraceLog(LOG_INFO, "WORLD: fertility map loaded from %s", fertility);
+    } else {
+        if (fertility != NULL && strcmp(fertility, "noise") != 0) {
+            TraceLog(LOG_WARNING, "WORLD: can't load fertility map %s — generating one", fertility);
+        }
+        FertilityGenerate(&w->fertility);
+    }
 
     /* Seed with full target amount */
     for (int i = 0; i < w->foodTarget; i++) SpawnFood(w);
 }
 
+void WorldFree(World *w) {
+    assert(w != NULL);
+    free(w->food);
+    free(w->foodFree);
+    FertilityFree(&w->fertility);
+    TimerWheelFree(&w->meatTimers);
+    SpatialFree(&w->foodGrid);
+    free(w->foodDirtyCells);
+    CellTableFree(&w->foodDirtySet);
+    memset(w, 0, sizeof(*w));
+}
+
 void WorldUpdate(World *w, float dt) {
     assert(w != NULL);
 
-    /* Rate-limited spawn, capped at w->foodTarget */
-    if (w->foodCount < w->foodTarget) {
+    /* Rate-limited plant spawn, capped at w->foodTarget (meat doesn't count) */
+    if (w->foodCount - w->meatCount < w->foodTarget) {
         w->foodSpawnTimer += dt;
         float interval = (w->foodSpawnRate > 0.0f) ? 1.0f / w->foodSpawnRate : 9999.0f;
-        while (w->foodSpawnTimer >= interval && w->foodCount < w->foodTarget) {
+        while (w->foodSpawnTimer >= interval && w->foodCount - w->meatCount < w->foodTarget) {
             SpawnFood(w);
             w->foodSpawnTimer -= interval;
         }
@@ -78,6 +165,7 @@ void WorldUpdate(World *w, float dt) {
     }
 
     w->tick++;
+    TimerWheelAdvance(&w->meatTimers, RotMeat, w);
 }
 
 int WorldFoodCount(const World *w) {
@@ -85,54 +173,107 @@ int WorldFoodCount(const World *w) {
     return w->foodCount;  /* O(1) — maintained incrementally */
 }
 
-/* Remove food item foodIdx from the spatial grid and decrement foodCount.
-   Must be called before marking the plant as eaten. */
-void WorldFoodGridRemove(World *w, int foodIdx) {
+bool WorldDropMeat(World *w, Vector2 pos, float nutrition) {
     assert(w != NULL);
-    assert(foodIdx >= 0 && foodIdx < MAX_FOOD);
+    int i = AllocFoodSlot(w);
+    if (i < 0) return false;
+    w->food[i].position  = pos;
+    w->food[i].nutrition = nutrition;
+    w->food[i].kind      = FOOD_MEAT;
+    w->food[i].eaten     = false;
+    FoodGridInsert(w, i);
+    w->meatCount++;
+    TimerWheelSchedule(&w->meatTimers, i, w->tick + MEAT_LIFETIME_TICKS);
+    return true;
+}
 
-    int cell = w->foodGridCell[foodIdx];
+void WorldFoodGridRemove(World *w, int foodIdx) {
+    WorldFoodGridUnlink(w, foodIdx);
+    w->food[foodIdx].eaten = true;
+    WorldFoodRelease(w, foodIdx);
+}
 
-    if (w->foodGridHead[cell] == foodIdx) {
-        w->foodGridHead[cell] = w->foodGridNext[foodIdx];
-    } else {
-        int prev = w->foodGridHead[cell];
-        while (prev != -1 && w->foodGridNext[prev] != foodIdx) {
-            prev = w->foodGridNext[prev];
-        }
-        if (prev != -1) w->foodGridNext[prev] = w->foodGridNext[foodIdx];
-    }
-    w->foodGridNext[foodIdx] = -1;
+void WorldFoodRelease(World *w, int foodIdx) {
+    assert(w != NULL);
+    assert(w->food[foodIdx].eaten);
     w->foodCount--;
+    if (w->food[foodIdx].kind == FOOD_MEAT) {
+        w->meatCount--;
+        TimerWheelCancel(&w->meatTimers, foodIdx);
+    }
+    WorldMarkFoodDirty(w, w->foodGrid.cell[foodIdx]);
+    w->foodFree[w->foodFreeCount++] = foodIdx;
 }
 
-void WorldDraw(const World *w) {
+void WorldMarkFoodDirty(World *w, int cell) {
     assert(w != NULL);
+    if (w->foodDirtyAll || CellTableGet(&w->foodDirtySet, cell) != -1) return;
+    if (w->foodDirtyCount == FOOD_DIRTY_MAX) {
+        WorldClearFoodDirty(w);
+        w->foodDirtyAll = true;
+        return;
+    }
+    CellTableSet(&w->foodDirtySet, cell, w->foodDirtyCount);
+    w->foodDirtyCells[w->foodDirtyCount++] = cell;
+}
 
-    /* World background */
-    DrawRectangle(0, 0, w->width, w->height, (Color){ 18, 38, 18, 255 });
+void WorldClearFoodDirty(World *w) {
+    assert(w != NULL);
+    for (int d = 0; d < w->foodDirtyCount; d++) CellTableSet(&w->foodDirtySet, w->foodDirtyCells[d], -1);
+    w->foodDirtyCount = 0;
+    w->foodDirtyAll   = false;
+}
 
-    /* Grid — 200px cells for the larger world */
-    const int gridStep = 200;
-    const Color gridColor = (Color){ 30, 55, 30, 255 };
-    for (int x = 0; x < w->width; x += gridStep)
-        DrawLine(x, 0, x, w->height, gridColor);
-    for (int y = 0; y < w->height; y += gridStep)
-        DrawLine(0, y, w->width, y, gridColor);
+/* Unlink food item foodIdx from its grid cell; the rest is left to WorldFoodRelease. */
+void WorldFoodGridUnlink(World *w, int foodIdx) {
+    assert(w != NULL);
+    assert(foodIdx >= 0 && foodIdx < w->foodCap);
+    SpatialUnlink(&w->foodGrid, foodIdx);
+}
+
+void WorldEmitFoodQuads(const World *w, Rectangle region, float half, unsigned char alpha) {
+    assert(w != NULL);
+    Rectangle reach = { region.x - half, region.y - half, region.width + 2.0f * half, region.height + 2.0f * half };
+    FoodQuads q     = { w, half, alpha };
+    SpatialQueryRect(&w->foodGrid, reach, EmitFoodQuad, &q);
+}
+
+void WorldDraw(const World *w, const WorldLayers *layers, Rectangle view, float zoom) {
+    assert(w != NULL);
+
+    /* Visible part of the world, in world px */
+    float vx0 = fmaxf(view.x, 0.0f);
+    float vy0 = fmaxf(view.y, 0.0f);
+    float vx1 = fminf(view.x + view.width,  (float)w->width);
+    float vy1 = fminf(view.y + view.height, (float)w->height);
+    if (vx1 <= vx0 || vy1 <= vy0) return;
+    Rectangle visible = { vx0, vy0, vx1 - vx0, vy1 - vy0 };
+
+    if (layers != NULL) {
+        /* Background + grid: one quad sampling the cached cell tile */
+        WorldLayersDrawStatic(layers, visible);
+    } else {
+        /* World background */
+        DrawRectangleRec(visible, (Color){ 18, 38, 18, 255 });
+
+        /* Grid — 200px cells for the larger world, only the lines in view */
+        const int gridStep = GRID_CELL_SIZE;
+        const Color gridColor = (Color){ 30, 55, 30, 255 };
+        for (int x = (int)ceilf(vx0 / gridStep) * gridStep; x < vx1; x += gridStep)
+            DrawLine(x, (int)vy0, x, (int)vy1, gridColor);
+        for (int y = (int)ceilf(vy0 / gridStep) * gridStep; y < vy1; y += gridStep)
+            DrawLine((int)vx0, y, (int)vx1, y, gridColor);
+    }
 
     /* World border — bright so it's visible when zoomed out */
     DrawRectangleLines(0, 0, w->width, w->height, (Color){ 80, 160, 80, 255 });
 
-    /* Food items */
-    const float half = FOOD_SIZE * 0.5f;
-    for (int i = 0; i < MAX_FOOD; i++) {
-        if (!w->plants[i].eaten) {
-            DrawRectangleV(
-                (Vector2){ w->plants[i].position.x - half,
-                           w->plants[i].position.y - half },
-                (Vector2){ FOOD_SIZE, FOOD_SIZE },
-                (Color){ 80, 200, 80, 220 }
-            );
-        }
-    }
+    /* Far zoom: food comes from the cached layer, patched incrementally */
+    if (layers != NULL && WorldLayersDrawFood(layers, visible, zoom)) return;
+
+    /* Food items — cells overlapping the view, one batch of quads,
+       never smaller than ~1 screen px so far-zoomed food stays visible */
+    rlBegin(RL_QUADS);
+    WorldEmitFoodQuads(w, visible, fmaxf(FOOD_SIZE, 1.0f / zoom) * 0.5f, 220);
+    rlEnd();
 }
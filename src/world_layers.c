@@ -0,0 +1,213 @@
+#include "world_layers.h"
+#include "config.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include "rlgl.h"
+
+/* ── Internal helpers ────────────────────────────────────────── */
+
+/* Fertility tint texels: green, opaque in proportion to weight / max weight */
+static Color *FertilityTexels(const FertilityMap *m) {
+    int    n  = m->cols * m->rows;
+    Color *px = malloc((size_t)n * sizeof(*px));
+    if (!px) TraceLog(LOG_FATAL, "LAYERS: out of memory painting fertility");
+
+    float maxWeight = 0.0f;
+    for (int i = 0; i < n; i++) maxWeight = fmaxf(maxWeight, m->weight[i]);
+    float k = maxWeight > 0.0f ? 110.0f / maxWeight : 0.0f;
+    for (int i = 0; i < n; i++) px[i] = (Color){ 70, 140, 40, (unsigned char)(m->weight[i] * k) };
+    return px;
+}
+
+/* Repaint the part of tile (tx, ty) that overlaps world rectangle `region`:
+   clear it, then redraw every food item that can touch it. */
+static void PaintFoodRegion(const WorldLayers *l, const World *w, int tx, int ty, Rectangle region) {
+    float ox = tx * l->tileWorld;
+    float oy = ty * l->tileWorld;
+
+    /* Clip the region to this tile in world px */
+    float rx0 = fmaxf(region.x, ox);
+    float ry0 = fmaxf(region.y, oy);
+    float rx1 = fminf(region.x + region.width,  ox + l->tileWorld);
+    float ry1 = fminf(region.y + region.height, oy + l->tileWorld);
+    if (rx1 <= rx0 || ry1 <= ry0) return;
+    region = (Rectangle){ rx0, ry0, rx1 - rx0, ry1 - ry0 };
+
+    /* Region in tile texels */
+    int x0 = (int)floorf((region.x - ox) * l->foodScale);
+    int y0 = (int)floorf((region.y - oy) * l->foodScale);
+    int x1 = (int)ceilf((region.x + region.width  - ox) * l->foodScale);
+    int y1 = (int)ceilf((region.y + region.height - oy) * l->foodScale);
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > l->tileTexels) x1 = l->tileTexels;
+    if (y1 > l->tileTexels) y1 = l->tileTexels;
+    if (x1 <= x0 || y1 <= y0) return;
+
+    /* Texels repainted, in world px — wider than region by the rounding */
+    float     half    = fmaxf(FOOD_SIZE, 1.0f / l->foodScale) * 0.5f;
+    Rectangle painted = { ox + x0 / l->foodScale, oy + y0 / l->foodScale,
+                          (x1 - x0) / l->foodScale, (y1 - y0) / l->foodScale };
+
+    Camera2D cam = { .offset = { 0.0f, 0.0f }, .target = { ox, oy }, .rotation = 0.0f, .zoom = l->foodScale };
+
+    BeginTextureMode(l->foodTiles[ty * l->tileCols + tx]);
+        BeginScissorMode(x0, y0, x1 - x0, y1 - y0);
+            ClearBackground(BLANK);   /* glClear honours the scissor rectangle */
+            BeginMode2D(cam);
+                /* Opaque in the layer; the layer itself is drawn translucent */
+                rlBegin(RL_QUADS);
+                WorldEmitFoodQuads(w, painted, half, 255);
+                rlEnd();
+            EndMode2D();
+        EndScissorMode();
+    EndTextureMode();
+}
+
+/* Repaint every tile overlapping world rectangle `region` */
+static void PaintFoodRect(const WorldLayers *l, const World *w, Rectangle region) {
+    int tx0 = (int)floorf(region.x / l->tileWorld);
+    int ty0 = (int)floorf(region.y / l->tileWorld);
+    int tx1 = (int)floorf((region.x + region.width)  / l->tileWorld);
+    int ty1 = (int)floorf((region.y + region.height) / l->tileWorld);
+    if (tx0 < 0) tx0 = 0;
+    if (ty0 < 0) ty0 = 0;
+    if (tx1 > l->tileCols - 1) tx1 = l->tileCols - 1;
+    if (ty1 > l->tileRows - 1) ty1 = l->tileRows - 1;
+
+    for (int ty = ty0; ty <= ty1; ty++) {
+        for (int tx = tx0; tx <= tx1; tx++) PaintFoodRegion(l, w, tx, ty, region);
+    }
+}
+
+/* ── Public API ──────────────────────────────────────────────── */
+
+void WorldLayersInit(WorldLayers *l, World *w) {
+    assert(l != NULL && w != NULL);
+
+    /* Static cell tile. Render textures come out vertically flipped when
+       drawn, so the horizontal grid line goes on the last row to show on top. */
+    l->cellTile = LoadRenderTexture(GRID_TILE_TEXELS, GRID_TILE_TEXELS);
+    BeginTextureMode(l->cellTile);
+        ClearBackground((Color){ 18, 38, 18, 255 });
+        DrawRectangle(0, 0, 1, GRID_TILE_TEXELS, (Color){ 30, 55, 30, 255 });
+        DrawRectangle(0, GRID_TILE_TEXELS - 1, GRID_TILE_TEXELS, 1, (Color){ 30, 55, 30, 255 });
+    EndTextureMode();
+    GenTextureMipmaps(&l->cellTile.texture);
+    SetTextureFilter(l->cellTile.texture, TEXTURE_FILTER_TRILINEAR);
+    SetTextureWrap(l->cellTile.texture, TEXTURE_WRAP_REPEAT);
+
+    /* Fertility tint, one texel per map cell */
+    Color *px = FertilityTexels(&w->fertility);
+    Image  img = { px, w->fertility.cols, w->fertility.rows, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    l->fertility        = LoadTextureFromImage(img);
+    l->fertilityBlock   = w->fertility.block;
+    l->fertilityVersion = w->fertility.version;
+    SetTextureFilter(l->fertility, TEXTURE_FILTER_BILINEAR);
+    free(px);
+
+    /* Food layer tiles: FOOD_TILE_CELLS grid cells on a side, widened in
+       steps of FOOD_TILE_CELLS until there are at most FOOD_TILE_MAX */
+    int tileCells = FOOD_TILE_CELLS;
+    for (;;) {
+        l->tileCols = (w->gridCols + tileCells - 1) / tileCells;
+        l->tileRows = (w->gridRows + tileCells - 1) / tileCells;
+        if ((long long)l->tileCols * l->tileRows <= FOOD_TILE_MAX) break;
+        tileCells += FOOD_TILE_CELLS;
+    }
+
+    /* Resolution: FOOD_LAYER_MAX_SCALE, reduced for huge worlds so all
+       tiles together stay within FOOD_LAYER_TEXEL_BUDGET */
+    int tileCount  = l->tileCols * l->tileRows;
+    int budgetEdge = (int)sqrtf((float)FOOD_LAYER_TEXEL_BUDGET / (float)tileCount);
+    l->tileWorld   = (float)tileCells * GRID_CELL_SIZE;
+    l->tileTexels  = (int)ceilf(l->tileWorld * FOOD_LAYER_MAX_SCALE);
+    if (l->tileTexels > budgetEdge) l->tileTexels = budgetEdge;
+    if (l->tileTexels < 1)          l->tileTexels = 1;
+    l->foodScale   = (float)l->tileTexels / l->tileWorld;
+    l->foodTiles   = malloc((size_t)tileCount * sizeof(*l->foodTiles));
+    if (!l->foodTiles) TraceLog(LOG_FATAL, "LAYERS: out of memory allocating food tiles");
+
+    for (int t = 0; t < tileCount; t++) {
+        l->foodTiles[t] = LoadRenderTexture(l->tileTexels, l->tileTexels);
+        SetTextureFilter(l->foodTiles[t].texture, TEXTURE_FILTER_BILINEAR);
+        BeginTextureMode(l->foodTiles[t]);
+            ClearBackground(BLANK);
+        EndTextureMode();
+    }
+
+    /* Initial full paint; everything is up to date afterwards */
+    PaintFoodRect(l, w, (Rectangle){ 0.0f, 0.0f, (float)w->width, (float)w->height });
+    WorldClearFoodDirty(w);
+}
+
+void WorldLayersFree(WorldLayers *l) {
+    assert(l != NULL);
+    for (int t = 0; t < l->tileCols * l->tileRows; t++) UnloadRenderTexture(l->foodTiles[t]);
+    free(l->foodTiles);
+    UnloadRenderTexture(l->cellTile);
+    UnloadTexture(l->fertility);
+    l->foodTiles = NULL;
+    l->tileCols  = 0;
+    l->tileRows  = 0;
+}
+
+void WorldLayersSync(WorldLayers *l, World *w) {
+    assert(l != NULL && w != NULL);
+
+    /* Grow each dirty cell by one texel so edge texels shared with a
+       neighbouring cell are repainted too; after an overflow, repaint all */
+    float pad = 1.0f / l->foodScale;
+    if (w->foodDirtyAll) PaintFoodRect(l, w, (Rectangle){ 0.0f, 0.0f, (float)w->width, (float)w->height });
+    for (int d = 0; d < w->foodDirtyCount; d++) {
+        int cell = w->foodDirtyCells[d];
+        float x = (float)(cell % w->gridCols * GRID_CELL_SIZE);
+        float y = (float)(cell / w->gridCols * GRID_CELL_SIZE);
+        PaintFoodRect(l, w, (Rectangle){ x - pad, y - pad,
+                                         GRID_CELL_SIZE + 2.0f * pad, GRID_CELL_SIZE + 2.0f * pad });
+    }
+    WorldClearFoodDirty(w);
+
+    if (l->fertilityVersion != w->fertility.version) {
+        Color *px = FertilityTexels(&w->fertility);
+        UpdateTexture(l->fertility, px);
+        l->fertilityVersion = w->fertility.version;
+        free(px);
+    }
+}
+
+void WorldLayersDrawStatic(const WorldLayers *l, Rectangle visible) {
+    assert(l != NULL);
+    const float k = (float)GRID_TILE_TEXELS / GRID_CELL_SIZE;  /* texels per world px */
+    Rectangle src = { visible.x * k, visible.y * k, visible.width * k, visible.height * k };
+    DrawTexturePro(l->cellTile.texture, src, visible, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+
+    const float c = 1.0f / (GRID_CELL_SIZE * l->fertilityBlock);  /* fertility texels per world px */
+    Rectangle fsrc = { visible.x * c, visible.y * c, visible.width * c, visible.height * c };
+    DrawTexturePro(l->fertility, fsrc, visible, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+}
+
+bool WorldLayersDrawFood(const WorldLayers *l, Rectangle visible, float zoom) {
+    assert(l != NULL);
+    if (zoom > l->foodScale) return false;
+
+    int tx0 = (int)(visible.x / l->tileWorld);
+    int ty0 = (int)(visible.y / l->tileWorld);
+    int tx1 = (int)((visible.x + visible.width)  / l->tileWorld);
+    int ty1 = (int)((visible.y + visible.height) / l->tileWorld);
+    if (tx1 > l->tileCols - 1) tx1 = l->tileCols - 1;
+    if (ty1 > l->tileRows - 1) ty1 = l->tileRows - 1;
+
+    /* Negative source height un-flips the render texture */
+    Rectangle src = { 0.0f, 0.0f, (float)l->tileTexels, -(float)l->tileTexels };
+    for (int ty = ty0; ty <= ty1; ty++) {
+        for (int tx = tx0; tx <= tx1; tx++) {
+            Rectangle dst = { tx * l->tileWorld, ty * l->tileWorld, l->tileWorld, l->tileWorld };
+            DrawTexturePro(l->foodTiles[ty * l->tileCols + tx].texture, src, dst,
+                           (Vector2){ 0.0f, 0.0f }, 0.0f, (Color){ 255, 255, 255, 220 });
+        }
+    }
+    return true;
+}
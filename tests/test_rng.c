@@ -0,0 +1,129 @@
+/* Statistical check of the bulk random source (rng.c) against the draw it
+   replaced, (float)GetRandomValue(0, 10000) / 10000: range, mean and
+   variance of the raw uniforms and of the ±width mutation steps built from
+   them, lag correlation across and within the interleaved lanes, and
+   reproducibility under SetRandomSeed. Exits non-zero on any failure. */
+
+#include "rng.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "raylib.h"
+
+#define SAMPLES      (1 << 20)
+#define STEP_WIDTH   0.5f     /* weight mutation step, genome.c */
+
+/* 1/12 is the variance of U[0, 1); with 2^20 samples the standard error of
+   the mean is ~2.8e-4 and of the variance ~7e-5, so these are > 7σ */
+#define TOL_MEAN     0.002
+#define TOL_VAR      0.0008
+#define TOL_CORR     0.006
+
+typedef struct {
+    double mean;
+    double var;
+    float  min, max;
+} Stats;
+
+static int s_failures = 0;
+
+static void Check(int ok, const char *what, double got, double want) {
+    printf("%-4s %-44s got %+.6f  want %+.6f\n", ok ? "ok" : "FAIL", what, got, want);
+    if (!ok) s_failures++;
+}
+
+static Stats Measure(const float *x, int n) {
+    Stats  s   = { 0.0, 0.0, x[0], x[0] };
+    double sum = 0.0, sumSq = 0.0;
+    for (int i = 0; i < n; i++) {
+        sum   += x[i];
+        sumSq += (double)x[i] * x[i];
+        if (x[i] < s.min) s.min = x[i];
+        if (x[i] > s.max) s.max = x[i];
+    }
+    s.mean = sum / n;
+    s.var  = sumSq / n - s.mean * s.mean;
+    return s;
+}
+
+/* Pearson correlation of x[i] with x[i + lag] */
+static double LagCorrelation(const float *x, int n, int lag) {
+    double sa = 0, sb = 0, saa = 0, sbb = 0, sab = 0;
+    int    m  = n - lag;
+    for (int i = 0; i < m; i++) {
+        double a = x[i], b = x[i + lag];
+        sa += a; sb += b; saa += a*a; sbb += b*b; sab += a*b;
+    }
+    double cov = sab / m - (sa / m) * (sb / m);
+    double va  = saa / m - (sa / m) * (sa / m);
+    double vb  = sbb / m - (sb / m) * (sb / m);
+    return cov / sqrt(va * vb);
+}
+
+/* Uniform draws and mutation steps of one source checked against theory */
+static void CheckSource(const char *name, const float *u, float hi) {
+    char   what[64];
+    Stats  s = Measure(u, SAMPLES);
+
+    snprintf(what, sizeof(what), "%s: min >= 0", name);
+    Check(s.min >= 0.0f, what, s.min, 0.0);
+    snprintf(what, sizeof(what), "%s: max <= %.8g", name, hi);
+    Check(s.max <= hi, what, s.max, hi);
+    snprintf(what, sizeof(what), "%s: mean", name);
+    Check(fabs(s.mean - 0.5) < TOL_MEAN, what, s.mean, 0.5);
+    snprintf(what, sizeof(what), "%s: variance", name);
+    Check(fabs(s.var - 1.0 / 12.0) < TOL_VAR, what, s.var, 1.0 / 12.0);
+
+    float *step = malloc(SAMPLES * sizeof(*step));
+    for (int i = 0; i < SAMPLES; i++) step[i] = (u[i] * 2.0f - 1.0f) * STEP_WIDTH;
+    Stats t = Measure(step, SAMPLES);
+    double wantVar = (double)STEP_WIDTH * STEP_WIDTH / 3.0;
+    snprintf(what, sizeof(what), "%s: step range", name);
+    Check(t.min >= -STEP_WIDTH && t.max <= STEP_WIDTH, what, t.max - t.min, 2.0 * STEP_WIDTH);
+    snprintf(what, sizeof(what), "%s: step mean", name);
+    Check(fabs(t.mean) < 2.0 * STEP_WIDTH * TOL_MEAN, what, t.mean, 0.0);
+    snprintf(what, sizeof(what), "%s: step variance", name);
+    Check(fabs(t.var - wantVar) < 4.0 * STEP_WIDTH * STEP_WIDTH * TOL_VAR, what, t.var, wantVar);
+    free(step);
+}
+
+int main(void) {
+    float *fresh = malloc(SAMPLES * sizeof(*fresh));
+    float *old   = malloc(SAMPLES * sizeof(*old));
+    float *again = malloc(SAMPLES * sizeof(*again));
+    if (!fresh || !old || !again) return 2;
+
+    SetRandomSeed(12345);
+    RngReseed();
+    RngUniforms(fresh, SAMPLES);
+    for (int i = 0; i < SAMPLES; i++) old[i] = (float)GetRandomValue(0, 10000) / 10000.0f;
+
+    /* The old draw is inclusive of 1; the bulk source never reaches it */
+    CheckSource("xoshiro", fresh, nextafterf(1.0f, 0.0f));
+    CheckSource("old", old, 1.0f);
+
+    Stats a = Measure(fresh, SAMPLES), b = Measure(old, SAMPLES);
+    Check(fabs(a.mean - b.mean) < 2.0 * TOL_MEAN, "xoshiro vs old: mean", a.mean, b.mean);
+    Check(fabs(a.var - b.var) < 2.0 * TOL_VAR, "xoshiro vs old: variance", a.var, b.var);
+
+    /* Lag 1 pairs neighbouring lanes, lag 8 one lane with its next step */
+    Check(fabs(LagCorrelation(fresh, SAMPLES, 1)) < TOL_CORR, "xoshiro: lag-1 correlation",
+          LagCorrelation(fresh, SAMPLES, 1), 0.0);
+    Check(fabs(LagCorrelation(fresh, SAMPLES, 8)) < TOL_CORR, "xoshiro: lag-8 correlation",
+          LagCorrelation(fresh, SAMPLES, 8), 0.0);
+
+    /* Same seed, same stream — whether drawn in bulk or one at a time */
+    SetRandomSeed(12345);
+    RngReseed();
+    for (int i = 0; i < SAMPLES; i++) again[i] = RngFloat();
+    int same = memcmp(fresh, again, SAMPLES * sizeof(*fresh)) == 0;
+    Check(same, "xoshiro: reseed reproduces the stream", same, 1.0);
+
+    free(fresh);
+    free(old);
+    free(again);
+    printf("%s\n", s_failures ? "FAILED" : "PASSED");
+    return s_failures ? 1 : 0;
+}